@@ -0,0 +1,60 @@
+#include <catch2/catch_all.hpp>
+#include <cask/ecs/world_snapshot.hpp>
+#include <cask/identity/uuid.hpp>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+struct Transform {
+    float pos_x;
+    float pos_y;
+    float pos_z;
+    float rot_y;
+    float scale;
+};
+
+struct Velocity {
+    float dx;
+    float dy;
+    float dz;
+};
+
+}
+
+TEST_CASE("world snapshot capture and restore", "[!benchmark][world_snapshot]") {
+    auto count = GENERATE(10'000u, 100'000u);
+
+    EntityTable table;
+    EntityRegistry registry;
+    ComponentStore<Transform> transforms;
+    ComponentStore<Velocity> velocities;
+    for (uint32_t index = 0; index < count; ++index) {
+        uint32_t entity = registry.resolve(cask::generate_uuid(), table);
+        float value = static_cast<float>(index);
+        transforms.insert(entity, Transform{value, 0.0f, -value, 0.5f, 1.0f});
+        if (index % 2 == 0) {
+            velocities.insert(entity, Velocity{1.0f, 0.0f, 0.0f});
+        }
+    }
+
+    WorldSnapshot snapshot;
+    snapshot.add(table);
+    snapshot.add(registry);
+    snapshot.add(transforms);
+    snapshot.add(velocities);
+
+    SnapshotArena arena;
+    snapshot.capture(arena);
+    std::string suffix = " x" + std::to_string(count);
+
+    BENCHMARK("capture" + suffix) {
+        snapshot.capture(arena);
+        return arena.size_;
+    };
+
+    BENCHMARK("restore" + suffix) {
+        snapshot.restore(arena);
+        return transforms.dense_.size();
+    };
+}
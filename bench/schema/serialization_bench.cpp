@@ -0,0 +1,75 @@
+#include <catch2/catch_all.hpp>
+#include <cask/ecs/component_store.hpp>
+#include <cask/schema/cask_component.hpp>
+#include <cask/schema/describe.hpp>
+#include <cask/schema/describe_component_store.hpp>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+CASK_COMPONENT(Transform, (float, pos_x), (float, pos_y), (float, pos_z), (float, rot_y), (float, scale))
+
+struct DescribedTransform {
+    float pos_x;
+    float pos_y;
+    float pos_z;
+    float rot_y;
+    float scale;
+};
+
+cask::RegistryEntry described_transform_entry() {
+    return cask::describe<DescribedTransform>("DescribedTransform", {
+        cask::field("pos_x", &DescribedTransform::pos_x),
+        cask::field("pos_y", &DescribedTransform::pos_y),
+        cask::field("pos_z", &DescribedTransform::pos_z),
+        cask::field("rot_y", &DescribedTransform::rot_y),
+        cask::field("scale", &DescribedTransform::scale)
+    });
+}
+
+template<typename T>
+ComponentStore<T> make_store(uint32_t count) {
+    ComponentStore<T> store;
+    for (uint32_t entity = 0; entity < count; ++entity) {
+        float value = static_cast<float>(entity);
+        store.insert(entity, T{value, 0.0f, -value, 0.5f, 1.0f});
+    }
+    return store;
+}
+
+cask::LoadContext identity_context(uint32_t count) {
+    cask::LoadContext context;
+    for (uint32_t entity = 0; entity < count; ++entity) {
+        context.entity_remap.set(entity, entity);
+    }
+    return context;
+}
+
+template<typename T>
+void benchmark_store(const std::string& label, const cask::RegistryEntry& store_entry, uint32_t count) {
+    auto store = make_store<T>(count);
+    auto data = store_entry.serialize(&store);
+    auto context = identity_context(count);
+    std::string suffix = " " + label + " x" + std::to_string(count);
+
+    BENCHMARK("save" + suffix) {
+        return store_entry.serialize(&store);
+    };
+
+    BENCHMARK("load" + suffix) {
+        ComponentStore<T> loaded;
+        store_entry.deserialize(data, &loaded, context);
+        return loaded.dense_.size();
+    };
+}
+
+}
+
+TEST_CASE("component store serialization throughput", "[!benchmark][serialization]") {
+    auto count = GENERATE(10'000u, 100'000u, 1'000'000u);
+
+    benchmark_store<DescribedTransform>("described", cask::describe_component_store<DescribedTransform>("Transforms", described_transform_entry()), count);
+    benchmark_store<Transform>("cask_component", cask::describe_component_store<Transform>("Transforms", Transform::describe()), count);
+    benchmark_store<Transform>("columns", cask::describe_component_columns<Transform>("Transforms", Transform::describe()), count);
+}
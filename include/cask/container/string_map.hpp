@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cask {
+
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view key) const noexcept {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+template<typename Value>
+using StringMap = std::unordered_map<std::string, Value, StringHash, std::equal_to<>>;
+
+template<typename Value>
+struct NameTable {
+    StringMap<uint32_t> ids_;
+    std::vector<std::string> names_;
+    std::deque<Value> values_;
+
+    uint32_t add(std::string_view name, Value value) {
+        if (auto existing = find(name)) {
+            return *existing;
+        }
+        auto id = static_cast<uint32_t>(values_.size());
+        ids_.emplace(std::string(name), id);
+        names_.emplace_back(name);
+        values_.push_back(std::move(value));
+        return id;
+    }
+
+    std::optional<uint32_t> find(std::string_view name) const {
+        auto found = ids_.find(name);
+        if (found == ids_.end()) {
+            return std::nullopt;
+        }
+        return found->second;
+    }
+
+    Value& at(uint32_t id) { return values_.at(id); }
+    const Value& at(uint32_t id) const { return values_.at(id); }
+    const std::string& name(uint32_t id) const { return names_.at(id); }
+    size_t size() const { return values_.size(); }
+};
+
+}
@@ -1,27 +1,38 @@
 #pragma once
 
+#include <cask/resource/resource_handle.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+enum class ComponentChange : uint8_t {
+    inserted,
+    modified,
+    removed
+};
+
 template<typename Component>
 struct ComponentStore {
     std::vector<Component> dense_;
     std::unordered_map<uint32_t, size_t> entity_to_index_;
-    std::unordered_map<size_t, uint32_t> index_to_entity_;
+    std::vector<uint32_t> index_to_entity_;
+    std::unordered_map<uint32_t, ComponentChange> changes_;
+    bool tracking_ = false;
 
     void insert(uint32_t entity, Component data) {
         size_t index = dense_.size();
         dense_.push_back(std::move(data));
         entity_to_index_[entity] = index;
-        index_to_entity_[index] = entity;
+        index_to_entity_.push_back(entity);
+        record(entity, ComponentChange::inserted);
     }
 
     template<typename Fn>
     void each(Fn callback) const {
-        for (const auto& [entity, index] : entity_to_index_) {
-            callback(entity, dense_[index]);
+        for (size_t index = 0; index < dense_.size(); ++index) {
+            callback(index_to_entity_[index], dense_[index]);
         }
     }
 
@@ -33,7 +44,53 @@ struct ComponentStore {
         return dense_[entity_to_index_[entity]];
     }
 
+    const Component& get(uint32_t entity) const {
+        return dense_[entity_to_index_.at(entity)];
+    }
+
+    Component& modify(uint32_t entity) {
+        touch(entity);
+        return get(entity);
+    }
+
+    void touch(uint32_t entity) {
+        record(entity, ComponentChange::modified);
+    }
+
+    void record(uint32_t entity, ComponentChange change) {
+        if (!tracking_) {
+            return;
+        }
+        auto [existing, added] = changes_.try_emplace(entity, change);
+        if (added) {
+            return;
+        }
+        if (change == ComponentChange::removed) {
+            if (existing->second == ComponentChange::inserted) {
+                changes_.erase(existing);
+            } else {
+                existing->second = ComponentChange::removed;
+            }
+        } else if (change == ComponentChange::inserted && existing->second == ComponentChange::removed) {
+            existing->second = ComponentChange::modified;
+        }
+    }
+
+    void rebase() {
+        changes_.clear();
+        tracking_ = true;
+    }
+
+    template<typename Fn>
+    void each_change(Fn callback) const {
+        for (const auto& [entity, change] : changes_) {
+            callback(entity, change);
+        }
+    }
+
     void remove(uint32_t entity) {
+        record(entity, ComponentChange::removed);
+
         size_t removed_index = entity_to_index_[entity];
         size_t last_index = dense_.size() - 1;
         uint32_t last_entity = index_to_entity_[last_index];
@@ -44,7 +101,7 @@ struct ComponentStore {
         index_to_entity_[removed_index] = last_entity;
 
         entity_to_index_.erase(entity);
-        index_to_entity_.erase(last_index);
+        index_to_entity_.pop_back();
 
         dense_.pop_back();
     }
@@ -54,5 +111,9 @@ using RemoveFn = void(*)(void*, uint32_t);
 
 template<typename Component>
 void remove_component(void* ptr, uint32_t entity) {
-    static_cast<ComponentStore<Component>*>(ptr)->remove(entity);
+    static_assert(!is_resource_handle_v<Component>, "resource handle components must be removed with remove_resource_component");
+    auto* store = static_cast<ComponentStore<Component>*>(ptr);
+    if (store->has(entity)) {
+        store->remove(entity);
+    }
 }
@@ -2,7 +2,7 @@
 
 #include <bitset>
 #include <cstdint>
-#include <queue>
+#include <deque>
 #include <unordered_map>
 #include <vector>
 
@@ -10,7 +10,7 @@ using Signature = std::bitset<64>;
 
 struct EntityTable {
     uint32_t next_id_ = 0;
-    std::queue<uint32_t> recycled_;
+    std::deque<uint32_t> recycled_;
     std::unordered_map<uint32_t, Signature> signatures_;
     std::vector<uint32_t> query_results_;
 
@@ -19,7 +19,7 @@ struct EntityTable {
             return next_id_++;
         }
         uint32_t recycled_id = recycled_.front();
-        recycled_.pop();
+        recycled_.pop_front();
         return recycled_id;
     }
 
@@ -31,7 +31,7 @@ struct EntityTable {
 
     void destroy(uint32_t entity) {
         signatures_.erase(entity);
-        recycled_.push(entity);
+        recycled_.push_back(entity);
     }
 
     bool alive(uint32_t entity) {
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <cask/ecs/component_store.hpp>
+#include <cask/ecs/entity_table.hpp>
+#include <cask/identity/entity_registry.hpp>
+#include <cask/resource/resource_handle.hpp>
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+inline constexpr size_t SNAPSHOT_ALIGNMENT = 64;
+
+// Storage is held in aligned blocks so offsets rounded to SNAPSHOT_ALIGNMENT are aligned
+// in memory too, and SnapshotReader can hand out typed spans over it.
+struct alignas(SNAPSHOT_ALIGNMENT) SnapshotBlock {
+    std::byte bytes[SNAPSHOT_ALIGNMENT];
+};
+
+inline size_t snapshot_blocks(size_t bytes) {
+    return (bytes + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT;
+}
+
+struct SnapshotArena {
+    std::vector<SnapshotBlock> blocks_;
+    size_t size_ = 0;
+
+    explicit SnapshotArena(size_t capacity = 0) : blocks_(snapshot_blocks(capacity)) {}
+
+    size_t capacity() const {
+        return blocks_.size() * SNAPSHOT_ALIGNMENT;
+    }
+
+    const std::byte* data() const {
+        return reinterpret_cast<const std::byte*>(blocks_.data());
+    }
+
+    void clear() {
+        size_ = 0;
+    }
+
+    std::byte* allocate(size_t size) {
+        size_t offset = (size_ + SNAPSHOT_ALIGNMENT - 1) & ~(SNAPSHOT_ALIGNMENT - 1);
+        if (offset + size > capacity()) {
+            blocks_.resize(std::max(snapshot_blocks(offset + size), blocks_.size() * 2));
+        }
+        size_ = offset + size;
+        return reinterpret_cast<std::byte*>(blocks_.data()) + offset;
+    }
+
+    template<typename T>
+    void value(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+        std::memcpy(allocate(sizeof(T)), &value, sizeof(T));
+    }
+
+    template<typename T>
+    void array(std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot arrays must be trivially copyable");
+        value<uint64_t>(values.size());
+        std::byte* target = allocate(values.size_bytes());
+        if (!values.empty()) {
+            std::memcpy(target, values.data(), values.size_bytes());
+        }
+    }
+
+    template<typename T>
+    T* array(size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot arrays must be trivially copyable");
+        value<uint64_t>(count);
+        return reinterpret_cast<T*>(allocate(count * sizeof(T)));
+    }
+};
+
+struct SnapshotReader {
+    const SnapshotArena& arena_;
+    size_t offset_ = 0;
+
+    explicit SnapshotReader(const SnapshotArena& arena) : arena_(arena) {}
+
+    const std::byte* take(size_t size) {
+        size_t offset = (offset_ + SNAPSHOT_ALIGNMENT - 1) & ~(SNAPSHOT_ALIGNMENT - 1);
+        if (offset + size > arena_.size_) {
+            throw std::runtime_error("world snapshot is truncated");
+        }
+        offset_ = offset + size;
+        return arena_.data() + offset;
+    }
+
+    template<typename T>
+    T value() {
+        T result;
+        std::memcpy(&result, take(sizeof(T)), sizeof(T));
+        return result;
+    }
+
+    template<typename T>
+    std::span<const T> array() {
+        auto count = static_cast<size_t>(value<uint64_t>());
+        return {reinterpret_cast<const T*>(take(count * sizeof(T))), count};
+    }
+};
+
+using CaptureFn = void(*)(const void*, SnapshotArena&);
+using RestoreFn = void(*)(void*, SnapshotReader&);
+
+template<typename Component>
+void capture_component_store(const void* ptr, SnapshotArena& arena) {
+    static_assert(std::is_trivially_copyable_v<Component>, "snapshots require trivially copyable components");
+    static_assert(!is_resource_handle_v<Component>, "restoring resource handles would bypass their reference counts");
+    const auto& store = *static_cast<const ComponentStore<Component>*>(ptr);
+    arena.array(std::span<const Component>(store.dense_));
+    arena.array(std::span<const uint32_t>(store.index_to_entity_));
+}
+
+template<typename Component>
+void restore_component_store(void* ptr, SnapshotReader& reader) {
+    auto& store = *static_cast<ComponentStore<Component>*>(ptr);
+    auto dense = reader.array<Component>();
+    auto entities = reader.array<uint32_t>();
+
+    if (store.tracking_) {
+        for (uint32_t entity : store.index_to_entity_) {
+            store.record(entity, ComponentChange::removed);
+        }
+    }
+
+    store.dense_.assign(dense.begin(), dense.end());
+    if (!std::ranges::equal(entities, store.index_to_entity_)) {
+        store.index_to_entity_.assign(entities.begin(), entities.end());
+        store.entity_to_index_.clear();
+        store.entity_to_index_.reserve(entities.size());
+        for (size_t index = 0; index < entities.size(); ++index) {
+            store.entity_to_index_.emplace(entities[index], index);
+        }
+    }
+
+    if (store.tracking_) {
+        for (uint32_t entity : store.index_to_entity_) {
+            store.record(entity, ComponentChange::inserted);
+        }
+    }
+}
+
+struct SnapshotSignature {
+    uint32_t entity;
+    uint64_t bits;
+};
+
+inline void capture_entity_table(const void* ptr, SnapshotArena& arena) {
+    const auto& table = *static_cast<const EntityTable*>(ptr);
+    arena.value(table.next_id_);
+
+    auto* recycled = arena.array<uint32_t>(table.recycled_.size());
+    std::copy(table.recycled_.begin(), table.recycled_.end(), recycled);
+
+    auto* signatures = arena.array<SnapshotSignature>(table.signatures_.size());
+    for (const auto& [entity, signature] : table.signatures_) {
+        *signatures++ = SnapshotSignature{entity, signature.to_ullong()};
+    }
+}
+
+inline void restore_entity_table(void* ptr, SnapshotReader& reader) {
+    auto& table = *static_cast<EntityTable*>(ptr);
+    table.next_id_ = reader.value<uint32_t>();
+
+    auto recycled = reader.array<uint32_t>();
+    table.recycled_.assign(recycled.begin(), recycled.end());
+
+    auto signatures = reader.array<SnapshotSignature>();
+    bool same_entities = signatures.size() == table.signatures_.size();
+    for (size_t index = 0; same_entities && index < signatures.size(); ++index) {
+        auto found = table.signatures_.find(signatures[index].entity);
+        if (found == table.signatures_.end()) {
+            same_entities = false;
+        } else {
+            found->second = Signature(signatures[index].bits);
+        }
+    }
+    if (same_entities) {
+        return;
+    }
+
+    table.signatures_.clear();
+    table.signatures_.reserve(signatures.size());
+    for (const auto& signature : signatures) {
+        table.signatures_.emplace(signature.entity, Signature(signature.bits));
+    }
+}
+
+struct SnapshotIdentity {
+    uint32_t entity;
+    cask::UUID uuid;
+};
+
+inline void capture_entity_registry(const void* ptr, SnapshotArena& arena) {
+    static_assert(std::is_trivially_copyable_v<cask::UUID>, "snapshots copy UUIDs bytewise");
+    const auto& registry = *static_cast<const EntityRegistry*>(ptr);
+    auto* identities = arena.array<SnapshotIdentity>(registry.size());
+    registry.each([&identities](uint32_t entity, const cask::UUID& uuid) {
+        *identities++ = SnapshotIdentity{entity, uuid};
+    });
+}
+
+inline void restore_entity_registry(void* ptr, SnapshotReader& reader) {
+    auto& registry = *static_cast<EntityRegistry*>(ptr);
+    auto identities = reader.array<SnapshotIdentity>();
+
+    bool unchanged = identities.size() == registry.size();
+    for (size_t index = 0; unchanged && index < identities.size(); ++index) {
+        auto found = registry.entity_to_uuid_.find(identities[index].entity);
+        unchanged = found != registry.entity_to_uuid_.end() && found->second == identities[index].uuid;
+    }
+    if (unchanged) {
+        return;
+    }
+
+    if (registry.tracking_) {
+        for (const auto& [entity, uuid] : registry.entity_to_uuid_) {
+            registry.record(uuid, entity, ComponentChange::removed);
+        }
+    }
+
+    registry.uuid_to_entity_.clear();
+    registry.entity_to_uuid_.clear();
+    registry.uuid_to_entity_.reserve(identities.size());
+    registry.entity_to_uuid_.reserve(identities.size());
+    for (const auto& identity : identities) {
+        registry.uuid_to_entity_.emplace(identity.uuid, identity.entity);
+        registry.entity_to_uuid_.emplace(identity.entity, identity.uuid);
+        registry.record(identity.uuid, identity.entity, ComponentChange::inserted);
+    }
+}
+
+struct WorldSnapshot {
+    struct Entry {
+        void* instance;
+        CaptureFn capture;
+        RestoreFn restore;
+    };
+
+    std::vector<Entry> entries_;
+
+    void add(void* instance, CaptureFn capture, RestoreFn restore) {
+        entries_.push_back(Entry{instance, capture, restore});
+    }
+
+    template<typename Component>
+    void add(ComponentStore<Component>& store) {
+        add(&store, capture_component_store<Component>, restore_component_store<Component>);
+    }
+
+    void add(EntityTable& table) {
+        add(&table, capture_entity_table, restore_entity_table);
+    }
+
+    void add(EntityRegistry& registry) {
+        add(&registry, capture_entity_registry, restore_entity_registry);
+    }
+
+    void capture(SnapshotArena& arena) const {
+        arena.clear();
+        arena.value<uint64_t>(entries_.size());
+        for (const auto& entry : entries_) {
+            entry.capture(entry.instance, arena);
+        }
+    }
+
+    void restore(const SnapshotArena& arena) const {
+        SnapshotReader reader(arena);
+        if (reader.value<uint64_t>() != entries_.size()) {
+            throw std::runtime_error("world snapshot does not match its entries");
+        }
+        for (const auto& entry : entries_) {
+            entry.restore(entry.instance, reader);
+        }
+    }
+};
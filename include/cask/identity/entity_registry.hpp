@@ -1,13 +1,22 @@
 #pragma once
 
+#include <cask/ecs/component_store.hpp>
 #include <cask/ecs/entity_table.hpp>
 #include <cask/identity/uuid.hpp>
+#include <cstdint>
 #include <stdexcept>
 #include <unordered_map>
 
+struct EntityRegistryChange {
+    uint32_t entity;
+    ComponentChange change;
+};
+
 struct EntityRegistry {
     std::unordered_map<cask::UUID, uint32_t> uuid_to_entity_;
     std::unordered_map<uint32_t, cask::UUID> entity_to_uuid_;
+    std::unordered_map<cask::UUID, EntityRegistryChange> changes_;
+    bool tracking_ = false;
 
     uint32_t resolve(const cask::UUID& uuid, EntityTable& table) {
         auto found = uuid_to_entity_.find(uuid);
@@ -17,6 +26,7 @@ struct EntityRegistry {
         uint32_t entity = table.create();
         uuid_to_entity_[uuid] = entity;
         entity_to_uuid_[entity] = uuid;
+        record(uuid, entity, ComponentChange::inserted);
         return entity;
     }
 
@@ -41,6 +51,9 @@ struct EntityRegistry {
         if (entity_found != entity_to_uuid_.end() && entity_found->second != uuid) {
             throw std::runtime_error("entity already has a different UUID");
         }
+        if (uuid_found == uuid_to_entity_.end()) {
+            record(uuid, entity, ComponentChange::inserted);
+        }
         uuid_to_entity_[uuid] = entity;
         entity_to_uuid_[entity] = uuid;
     }
@@ -53,6 +66,40 @@ struct EntityRegistry {
         cask::UUID uuid = found->second;
         entity_to_uuid_.erase(found);
         uuid_to_entity_.erase(uuid);
+        record(uuid, entity, ComponentChange::removed);
+    }
+
+    // Tracked by UUID, so an entity id recycled within one baseline still reports the
+    // removed UUID and the added one separately.
+    void record(const cask::UUID& uuid, uint32_t entity, ComponentChange change) {
+        if (!tracking_) {
+            return;
+        }
+        auto [existing, added] = changes_.try_emplace(uuid, EntityRegistryChange{entity, change});
+        if (added) {
+            return;
+        }
+        if (change == ComponentChange::removed) {
+            if (existing->second.change == ComponentChange::inserted) {
+                changes_.erase(existing);
+            } else {
+                existing->second = EntityRegistryChange{entity, ComponentChange::removed};
+            }
+        } else {
+            existing->second = EntityRegistryChange{entity, ComponentChange::modified};
+        }
+    }
+
+    void rebase() {
+        changes_.clear();
+        tracking_ = true;
+    }
+
+    template<typename Fn>
+    void each_change(Fn callback) const {
+        for (const auto& [uuid, change] : changes_) {
+            callback(uuid, change.entity, change.change);
+        }
     }
 
     size_t size() const {
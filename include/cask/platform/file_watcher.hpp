@@ -0,0 +1,113 @@
+#pragma once
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <climits>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace cask {
+
+// Reports files that were written or replaced since the last poll. On Linux the
+// parent directories are watched with inotify, so editors that save by renaming
+// a temporary file over the original are still seen. Elsewhere modification
+// times are compared on every poll.
+struct FileWatcher {
+    std::unordered_set<std::string> files_;
+#if defined(__linux__)
+    int descriptor_ = -1;
+    std::unordered_map<int, std::string> directories_;
+    std::unordered_map<std::string, int> directory_watches_;
+#else
+    std::unordered_map<std::string, std::filesystem::file_time_type> modified_;
+#endif
+
+    FileWatcher() {
+#if defined(__linux__)
+        descriptor_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (descriptor_ < 0) {
+            throw std::runtime_error("cannot create file watcher");
+        }
+#endif
+    }
+
+    ~FileWatcher() {
+#if defined(__linux__)
+        close(descriptor_);
+#endif
+    }
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    static std::string normalize(const std::string& path) {
+        return std::filesystem::absolute(path).lexically_normal().string();
+    }
+
+    void watch(const std::string& path) {
+        std::string file = normalize(path);
+        if (!files_.insert(file).second) {
+            return;
+        }
+#if defined(__linux__)
+        std::string directory = std::filesystem::path(file).parent_path().string();
+        if (directory_watches_.count(directory) != 0) {
+            return;
+        }
+        int watch = inotify_add_watch(descriptor_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (watch < 0) {
+            files_.erase(file);
+            throw std::runtime_error("cannot watch directory: " + directory);
+        }
+        directories_[watch] = directory;
+        directory_watches_[directory] = watch;
+#else
+        std::error_code error;
+        modified_[file] = std::filesystem::last_write_time(file, error);
+#endif
+    }
+
+    std::vector<std::string> poll() {
+        std::unordered_set<std::string> changed;
+#if defined(__linux__)
+        alignas(inotify_event) char buffer[sizeof(inotify_event) + NAME_MAX + 1];
+        while (true) {
+            ssize_t length = read(descriptor_, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+            for (char* cursor = buffer; cursor < buffer + length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(cursor);
+                cursor += sizeof(inotify_event) + event->len;
+                auto directory = directories_.find(event->wd);
+                if (event->len == 0 || directory == directories_.end()) {
+                    continue;
+                }
+                std::string file = directory->second + "/" + event->name;
+                if (files_.count(file) != 0) {
+                    changed.insert(std::move(file));
+                }
+            }
+        }
+#else
+        for (auto& [file, modified] : modified_) {
+            std::error_code error;
+            auto current = std::filesystem::last_write_time(file, error);
+            if (!error && current != modified) {
+                modified = current;
+                changed.insert(file);
+            }
+        }
+#endif
+        return {changed.begin(), changed.end()};
+    }
+};
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#if defined(__APPLE__) || defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#else
+static_assert(false, "Unsupported platform");
+#endif
+
+namespace cask {
+
+struct MappedFile {
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+    explicit MappedFile(const std::string& path) {
+#if defined(__APPLE__) || defined(__linux__)
+        int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("cannot open file for mapping: " + path);
+        }
+        struct stat info{};
+        if (fstat(descriptor, &info) != 0) {
+            close(descriptor);
+            throw std::runtime_error("cannot stat file for mapping: " + path);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapped == MAP_FAILED) {
+                close(descriptor);
+                throw std::runtime_error("cannot map file: " + path);
+            }
+            madvise(mapped, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const std::byte*>(mapped);
+        }
+        close(descriptor);
+#elif defined(_WIN32)
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("cannot open file for mapping: " + path);
+        }
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file_, &file_size)) {
+            CloseHandle(file_);
+            throw std::runtime_error("cannot stat file for mapping: " + path);
+        }
+        size_ = static_cast<size_t>(file_size.QuadPart);
+        if (size_ > 0) {
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_ == nullptr) {
+                CloseHandle(file_);
+                throw std::runtime_error("cannot map file: " + path);
+            }
+            data_ = static_cast<const std::byte*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+            if (data_ == nullptr) {
+                CloseHandle(mapping_);
+                CloseHandle(file_);
+                throw std::runtime_error("cannot map file: " + path);
+            }
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(__APPLE__) || defined(__linux__)
+        if (data_ != nullptr) {
+            munmap(const_cast<std::byte*>(data_), size_);
+        }
+#elif defined(_WIN32)
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != nullptr) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const std::byte> bytes() const {
+        return {data_, size_};
+    }
+};
+
+}
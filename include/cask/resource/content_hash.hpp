@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace cask {
+
+inline constexpr uint64_t HASH_PRIME_1 = 0x9E3779B185EBCA87ULL;
+inline constexpr uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+inline constexpr uint64_t HASH_PRIME_3 = 0x165667B19E3779F9ULL;
+inline constexpr uint64_t HASH_PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+inline constexpr uint64_t HASH_PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t hash_rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t hash_read64(const unsigned char* bytes) {
+    uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline uint32_t hash_read32(const unsigned char* bytes) {
+    uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline uint64_t hash_round(uint64_t accumulator, uint64_t input) {
+    accumulator += input * HASH_PRIME_2;
+    accumulator = hash_rotl(accumulator, 31);
+    return accumulator * HASH_PRIME_1;
+}
+
+inline uint64_t hash_merge(uint64_t hash, uint64_t accumulator) {
+    hash ^= hash_round(0, accumulator);
+    return hash * HASH_PRIME_1 + HASH_PRIME_4;
+}
+
+inline uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    const auto* end = bytes + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t lane_1 = seed + HASH_PRIME_1 + HASH_PRIME_2;
+        uint64_t lane_2 = seed + HASH_PRIME_2;
+        uint64_t lane_3 = seed;
+        uint64_t lane_4 = seed - HASH_PRIME_1;
+        const auto* limit = end - 32;
+        do {
+            lane_1 = hash_round(lane_1, hash_read64(bytes));
+            lane_2 = hash_round(lane_2, hash_read64(bytes + 8));
+            lane_3 = hash_round(lane_3, hash_read64(bytes + 16));
+            lane_4 = hash_round(lane_4, hash_read64(bytes + 24));
+            bytes += 32;
+        } while (bytes <= limit);
+
+        hash = hash_rotl(lane_1, 1) + hash_rotl(lane_2, 7) + hash_rotl(lane_3, 12) + hash_rotl(lane_4, 18);
+        hash = hash_merge(hash, lane_1);
+        hash = hash_merge(hash, lane_2);
+        hash = hash_merge(hash, lane_3);
+        hash = hash_merge(hash, lane_4);
+    } else {
+        hash = seed + HASH_PRIME_5;
+    }
+
+    hash += static_cast<uint64_t>(size);
+
+    while (bytes + 8 <= end) {
+        hash ^= hash_round(0, hash_read64(bytes));
+        hash = hash_rotl(hash, 27) * HASH_PRIME_1 + HASH_PRIME_4;
+        bytes += 8;
+    }
+    if (bytes + 4 <= end) {
+        hash ^= static_cast<uint64_t>(hash_read32(bytes)) * HASH_PRIME_1;
+        hash = hash_rotl(hash, 23) * HASH_PRIME_2 + HASH_PRIME_3;
+        bytes += 4;
+    }
+    while (bytes < end) {
+        hash ^= static_cast<uint64_t>(*bytes) * HASH_PRIME_5;
+        hash = hash_rotl(hash, 11) * HASH_PRIME_1;
+        bytes++;
+    }
+
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+template<typename T, typename Allocator>
+uint64_t hash_vector(const std::vector<T, Allocator>& values, uint64_t seed = 0) {
+    return hash_bytes(values.data(), values.size() * sizeof(T), seed);
+}
+
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cask/task/worker_pool.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cask {
+
+struct LoadFailure {
+    std::string key;
+    std::exception_ptr error;
+};
+
+inline std::string describe_load_failures(std::string message, const std::vector<LoadFailure>& failures) {
+    for (size_t index = 0; index < failures.size(); ++index) {
+        message += index == 0 ? ": " : "; ";
+        message += failures[index].key;
+        try {
+            std::rethrow_exception(failures[index].error);
+        } catch (const std::exception& error) {
+            message += " (" + std::string(error.what()) + ")";
+        } catch (...) {
+        }
+    }
+    return message;
+}
+
+// Collects the results of loader jobs run on a WorkerPool until the owning thread takes them,
+// so loads finish in the background but only touch a ResourceStore at a commit point.
+template<typename Loaded>
+struct LoadBatch {
+    using Job = std::function<Loaded()>;
+
+    struct Results {
+        std::vector<Loaded> loaded;
+        std::vector<LoadFailure> failed;
+    };
+
+    WorkerPool& pool_;
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    std::vector<Loaded> loaded_;
+    std::vector<LoadFailure> failed_;
+    size_t in_flight_ = 0;
+
+    explicit LoadBatch(WorkerPool& pool) : pool_(pool) {}
+
+    LoadBatch(const LoadBatch&) = delete;
+    LoadBatch& operator=(const LoadBatch&) = delete;
+
+    ~LoadBatch() {
+        wait();
+    }
+
+    void submit(std::string key, Job job) {
+        {
+            std::lock_guard lock(mutex_);
+            in_flight_++;
+        }
+        pool_.submit([this, key = std::move(key), job = std::move(job)] {
+            std::optional<Loaded> loaded;
+            std::exception_ptr error;
+            try {
+                loaded.emplace(job());
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard lock(mutex_);
+            if (error) {
+                failed_.push_back(LoadFailure{key, error});
+            } else {
+                loaded_.push_back(std::move(*loaded));
+            }
+            in_flight_--;
+            idle_.notify_all();
+        });
+    }
+
+    size_t pending() {
+        std::lock_guard lock(mutex_);
+        return in_flight_ + loaded_.size();
+    }
+
+    Results take() {
+        std::lock_guard lock(mutex_);
+        return Results{std::exchange(loaded_, {}), std::exchange(failed_, {})};
+    }
+
+    void wait() {
+        while (true) {
+            {
+                std::lock_guard lock(mutex_);
+                if (in_flight_ == 0) {
+                    return;
+                }
+            }
+            if (pool_.run_one()) {
+                continue;
+            }
+            std::unique_lock lock(mutex_);
+            idle_.wait(lock, [this] { return in_flight_ == 0; });
+            return;
+        }
+    }
+};
+
+}
@@ -1,21 +1,41 @@
 #pragma once
 
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <cask/resource/content_hash.hpp>
+#include <cask/resource/payload_allocator.hpp>
+#include <cask/resource/resource_blob.hpp>
 #include <cask/resource/resource_handle.hpp>
+#include <cask/resource/vertex_compression.hpp>
+#include <cask/resource/vertex_layout.hpp>
 
 using MeshHandle = ResourceHandle<struct MeshData>;
 
 struct MeshData {
 private:
-    std::vector<float> positions_;
-    std::vector<uint32_t> indices_;
-    std::vector<float> normals_;
-    std::vector<float> uvs_;
+    cask::PayloadVector<float> positions_;
+    cask::PayloadVector<uint32_t> indices_;
+    cask::PayloadVector<uint16_t> short_indices_;
+    MeshFormat format_;
+    cask::PayloadVector<float> normals_;
+    cask::PayloadVector<int16_t> packed_normals_;
+    cask::PayloadVector<float> uvs_;
+    cask::PayloadVector<uint16_t> packed_uvs_;
+    VertexLayout vertex_layout_;
+    cask::PayloadVector<std::byte> vertex_buffer_;
 
-    static void validate_positions(const std::vector<float>& positions) {
+    MeshData() = default;
+
+    static void validate_positions(std::span<const float> positions) {
         if (positions.empty()) {
             throw std::runtime_error("positions must not be empty");
         }
@@ -24,13 +44,19 @@ private:
         }
     }
 
-    static void validate_indices(const std::vector<uint32_t>& indices) {
+    template<typename Indices>
+    static void validate_indices(const Indices& indices, size_t vertex_count) {
         if (indices.empty()) {
             throw std::runtime_error("indices must not be empty");
         }
+        for (auto index : indices) {
+            if (index >= vertex_count) {
+                throw std::runtime_error("indices must reference existing vertices");
+            }
+        }
     }
 
-    static void validate_normals(const std::vector<float>& normals, const std::vector<float>& positions) {
+    static void validate_normals(std::span<const float> normals, std::span<const float> positions) {
         if (normals.empty()) {
             return;
         }
@@ -39,7 +65,7 @@ private:
         }
     }
 
-    static void validate_uvs(const std::vector<float>& uvs, const std::vector<float>& positions) {
+    static void validate_uvs(std::span<const float> uvs, std::span<const float> positions) {
         if (uvs.empty()) {
             return;
         }
@@ -48,19 +74,279 @@ private:
         }
     }
 
-public:
-    MeshData(std::vector<float> positions, std::vector<uint32_t> indices, std::vector<float> normals = {}, std::vector<float> uvs = {})
-        : positions_(std::move(positions)), indices_(std::move(indices)), normals_(std::move(normals)), uvs_(std::move(uvs)) {
+    static void validate_format(const MeshFormat& format) {
+        if (format.indices > IndexFormat::uint32 || format.normals > NormalFormat::octahedral || format.uvs > UvFormat::half2) {
+            throw std::runtime_error("mesh format is unknown");
+        }
+        if (!(format.uv_tolerance >= 0.0f)) {
+            throw std::runtime_error("uv tolerance must not be negative");
+        }
+    }
+
+    static void validate_packed(size_t floats, size_t packed, bool is_packed, size_t packed_per_vertex, size_t vertex_count) {
+        if (is_packed ? floats != 0 : packed != 0) {
+            throw std::runtime_error("mesh attribute is stored in both float and packed form");
+        }
+        if (packed != 0 && packed != vertex_count * packed_per_vertex) {
+            throw std::runtime_error("packed attribute size must match the vertex count");
+        }
+    }
+
+    void validate_storage() const {
         validate_positions(positions_);
-        validate_indices(indices_);
+        validate_format(format_);
+        size_t vertices = vertex_count();
+        if (format_.indices == IndexFormat::uint16) {
+            if (!indices_.empty()) {
+                throw std::runtime_error("mesh indices are stored at both widths");
+            }
+            validate_indices(short_indices_, vertices);
+        } else {
+            if (!short_indices_.empty()) {
+                throw std::runtime_error("mesh indices are stored at both widths");
+            }
+            validate_indices(indices_, vertices);
+        }
         validate_normals(normals_, positions_);
         validate_uvs(uvs_, positions_);
+        validate_packed(normals_.size(), packed_normals_.size(), format_.normals == NormalFormat::octahedral, 2, vertices);
+        validate_packed(uvs_.size(), packed_uvs_.size(), format_.uvs == UvFormat::half2, 2, vertices);
+
+        if (vertex_buffer_.empty()) {
+            if (!vertex_layout_.elements.empty() || vertex_layout_.stride != 0) {
+                throw std::runtime_error("vertex layout has no vertex buffer");
+            }
+            return;
+        }
+        validate_vertex_layout(vertex_layout_);
+        for (const auto& element : vertex_layout_.elements) {
+            if ((element.attribute == VertexAttribute::normal && !has_normals()) || (element.attribute == VertexAttribute::uv && !has_uvs())) {
+                throw std::runtime_error("vertex layout requests an attribute the mesh does not have");
+            }
+        }
+        if (vertex_buffer_.size() != vertices * vertex_layout_.stride) {
+            throw std::runtime_error("vertex buffer size must equal vertex count * stride");
+        }
+    }
+
+    template<typename Source, typename Target>
+    static void adopt(Source&& source, Target& target) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<Source>, Target> && !std::is_lvalue_reference_v<Source>) {
+            target = std::move(source);
+        } else {
+            target.assign(std::ranges::begin(source), std::ranges::end(source));
+        }
+    }
+
+    // Streams arriving as PayloadVector rvalues become the mesh's storage; anything else is
+    // copied or encoded straight into pooled storage, so no second float copy is made.
+    template<typename Positions, typename Indices, typename Normals, typename Uvs>
+    void build(Positions&& positions, Indices&& indices, Normals&& normals, Uvs&& uvs) {
+        validate_positions(positions);
+        validate_indices(indices, std::ranges::size(positions) / 3);
+        validate_normals(normals, positions);
+        validate_uvs(uvs, positions);
+        validate_format(format_);
+
+        if (format_.indices == IndexFormat::uint16) {
+            format_.indices = select_index_format(indices);
+        }
+        if (format_.indices == IndexFormat::uint16) {
+            short_indices_.assign(std::ranges::begin(indices), std::ranges::end(indices));
+        } else {
+            adopt(std::forward<Indices>(indices), indices_);
+        }
+        if (format_.normals == NormalFormat::octahedral) {
+            packed_normals_.resize(std::ranges::size(normals) / 3 * 2);
+            encode_normals(normals, packed_normals_);
+        } else {
+            adopt(std::forward<Normals>(normals), normals_);
+        }
+        if (format_.uvs == UvFormat::half2 && !halves_within(uvs, format_.uv_tolerance)) {
+            format_.uvs = UvFormat::float2;
+        }
+        if (format_.uvs == UvFormat::half2) {
+            packed_uvs_.resize(std::ranges::size(uvs));
+            encode_halves(uvs, packed_uvs_);
+        } else {
+            adopt(std::forward<Uvs>(uvs), uvs_);
+        }
+        adopt(std::forward<Positions>(positions), positions_);
+    }
+
+public:
+    MeshData(cask::PayloadVector<float> positions, cask::PayloadVector<uint32_t> indices, cask::PayloadVector<float> normals = {}, cask::PayloadVector<float> uvs = {}, MeshFormat format = {})
+        : format_(format) {
+        build(std::move(positions), std::move(indices), std::move(normals), std::move(uvs));
+    }
+
+    template<typename Positions>
+        requires std::ranges::contiguous_range<Positions> && std::same_as<std::ranges::range_value_t<Positions>, float>
+    MeshData(const Positions& positions, const std::vector<uint32_t>& indices, const std::vector<float>& normals = {}, const std::vector<float>& uvs = {}, MeshFormat format = {})
+        : format_(format) {
+        build(positions, indices, normals, uvs);
+    }
+
+    bool has_normals() const { return !normals_.empty() || !packed_normals_.empty(); }
+    bool has_uvs() const { return !uvs_.empty() || !packed_uvs_.empty(); }
+    std::span<const float> positions() const { return positions_; }
+    const MeshFormat& format() const { return format_; }
+    IndexFormat index_format() const { return format_.indices; }
+
+    size_t index_count() const {
+        return format_.indices == IndexFormat::uint16 ? short_indices_.size() : indices_.size();
+    }
+
+    std::vector<uint32_t> indices() const {
+        if (format_.indices == IndexFormat::uint16) {
+            return std::vector<uint32_t>(short_indices_.begin(), short_indices_.end());
+        }
+        return std::vector<uint32_t>(indices_.begin(), indices_.end());
+    }
+
+    std::vector<float> normals() const {
+        if (format_.normals == NormalFormat::octahedral) {
+            return decode_normals(packed_normals_);
+        }
+        return std::vector<float>(normals_.begin(), normals_.end());
+    }
+
+    std::vector<float> uvs() const {
+        if (format_.uvs == UvFormat::half2) {
+            return decode_halves(packed_uvs_);
+        }
+        return std::vector<float>(uvs_.begin(), uvs_.end());
+    }
+
+    // The stored float streams without a copy; these throw when the mesh keeps them packed.
+    std::span<const uint32_t> indices_raw() const {
+        if (format_.indices == IndexFormat::uint16) {
+            throw std::runtime_error("mesh indices are stored as uint16; use indices()");
+        }
+        return indices_;
+    }
+
+    std::span<const float> normals_raw() const {
+        if (format_.normals == NormalFormat::octahedral) {
+            throw std::runtime_error("mesh normals are stored octahedral; use normals()");
+        }
+        return normals_;
+    }
+
+    std::span<const float> uvs_raw() const {
+        if (format_.uvs == UvFormat::half2) {
+            throw std::runtime_error("mesh uvs are stored as halves; use uvs()");
+        }
+        return uvs_;
+    }
+
+    std::span<const uint16_t> short_indices() const { return short_indices_; }
+    std::span<const uint32_t> long_indices() const { return indices_; }
+    std::span<const int16_t> packed_normals() const { return packed_normals_; }
+    std::span<const uint16_t> packed_uvs() const { return packed_uvs_; }
+
+    const VertexLayout& vertex_layout() const { return vertex_layout_; }
+    std::span<const std::byte> vertex_buffer() const { return vertex_buffer_; }
+    bool has_vertex_buffer() const { return !vertex_buffer_.empty(); }
+    size_t vertex_count() const { return positions_.size() / 3; }
+
+    std::vector<float> attribute(VertexAttribute which) const {
+        switch (which) {
+            case VertexAttribute::position: return std::vector<float>(positions_.begin(), positions_.end());
+            case VertexAttribute::normal: return normals();
+            case VertexAttribute::uv: return uvs();
+        }
+        throw std::runtime_error("unknown vertex attribute");
+    }
+
+    void interleave(const VertexLayout& layout) {
+        validate_vertex_layout(layout);
+        std::vector<std::vector<float>> sources;
+        for (const auto& element : layout.elements) {
+            sources.push_back(attribute(element.attribute));
+            if (sources.back().empty()) {
+                throw std::runtime_error("vertex layout requests an attribute the mesh does not have");
+            }
+        }
+
+        size_t count = vertex_count();
+        cask::PayloadVector<std::byte> buffer(count * layout.stride);
+        for (size_t index = 0; index < layout.elements.size(); ++index) {
+            const auto& element = layout.elements[index];
+            const float* source = sources[index].data();
+            uint32_t bytes = attribute_bytes(element.attribute);
+            uint32_t components = attribute_components(element.attribute);
+            std::byte* target = buffer.data() + element.offset;
+            for (size_t vertex = 0; vertex < count; ++vertex) {
+                std::memcpy(target, source + vertex * components, bytes);
+                target += layout.stride;
+            }
+        }
+
+        vertex_layout_ = layout;
+        vertex_buffer_ = std::move(buffer);
+    }
+
+    size_t byte_size() const {
+        size_t floats = positions_.size() + normals_.size() + uvs_.size();
+        size_t packed = short_indices_.size() * sizeof(uint16_t) + packed_normals_.size() * sizeof(int16_t) + packed_uvs_.size() * sizeof(uint16_t);
+        return floats * sizeof(float) + indices_.size() * sizeof(uint32_t) + packed + vertex_buffer_.size();
     }
 
-    bool has_normals() const { return !normals_.empty(); }
-    bool has_uvs() const { return !uvs_.empty(); }
-    const std::vector<float>& positions() const { return positions_; }
-    const std::vector<uint32_t>& indices() const { return indices_; }
-    const std::vector<float>& normals() const { return normals_; }
-    const std::vector<float>& uvs() const { return uvs_; }
+    void write_blob(cask::BlobWriter& writer) const {
+        writer.value(format_);
+        writer.array(positions_);
+        writer.array(indices_);
+        writer.array(short_indices_);
+        writer.array(normals_);
+        writer.array(packed_normals_);
+        writer.array(uvs_);
+        writer.array(packed_uvs_);
+        writer.value(vertex_layout_.stride);
+        writer.array(vertex_layout_.elements);
+        writer.array(vertex_buffer_);
+    }
+
+    static MeshData read_blob(cask::BlobReader& reader) {
+        MeshData mesh;
+        mesh.format_ = reader.value<MeshFormat>();
+        reader.array(mesh.positions_);
+        reader.array(mesh.indices_);
+        reader.array(mesh.short_indices_);
+        reader.array(mesh.normals_);
+        reader.array(mesh.packed_normals_);
+        reader.array(mesh.uvs_);
+        reader.array(mesh.packed_uvs_);
+        mesh.vertex_layout_.stride = reader.value<uint32_t>();
+        reader.array(mesh.vertex_layout_.elements);
+        reader.array(mesh.vertex_buffer_);
+        mesh.validate_storage();
+        return mesh;
+    }
+
+    uint64_t content_hash() const {
+        uint64_t hash = cask::hash_vector(positions_);
+        hash = cask::hash_vector(indices_, hash);
+        hash = cask::hash_vector(short_indices_, hash);
+        hash = cask::hash_vector(normals_, hash);
+        hash = cask::hash_vector(packed_normals_, hash);
+        hash = cask::hash_vector(uvs_, hash);
+        return cask::hash_vector(packed_uvs_, hash);
+    }
+
+    bool operator==(const MeshData& other) const {
+        return positions_ == other.positions_ && indices_ == other.indices_ && short_indices_ == other.short_indices_
+            && normals_ == other.normals_ && packed_normals_ == other.packed_normals_
+            && uvs_ == other.uvs_ && packed_uvs_ == other.packed_uvs_;
+    }
 };
+
+inline MeshData placeholder_mesh() {
+    return MeshData({0, 0, 0}, {0, 0, 0});
+}
+
+inline MeshData compact_mesh(const std::vector<float>& positions, const std::vector<uint32_t>& indices, const std::vector<float>& normals = {}, const std::vector<float>& uvs = {}) {
+    MeshFormat format = select_mesh_format(uvs);
+    format.indices = IndexFormat::uint16;
+    return MeshData(positions, indices, normals, uvs, format);
+}
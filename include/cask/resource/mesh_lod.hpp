@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <cask/resource/content_hash.hpp>
+#include <cask/resource/mesh_data.hpp>
+#include <cask/resource/mesh_lod_descriptor.hpp>
+#include <cask/resource/mesh_optimizer.hpp>
+#include <cask/resource/resource_blob.hpp>
+#include <cask/resource/resource_handle.hpp>
+#include <cask/resource/resource_loader_registry.hpp>
+
+using MeshLodHandle = ResourceHandle<struct MeshLodChain>;
+
+inline constexpr double BORDER_QUADRIC_WEIGHT = 10.0;
+
+inline constexpr double QUADRIC_SINGULAR_DETERMINANT = 1e-6;
+
+// Planes are weighted by area, and the total weight is kept so error() is a weighted mean
+// squared distance to the planes, in world units whatever the mesh scale or tessellation.
+struct MeshQuadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+    double weight = 0;
+
+    static MeshQuadric plane(double a, double b, double c, double d, double weight) {
+        return MeshQuadric{
+            weight * a * a, weight * a * b, weight * a * c, weight * a * d,
+            weight * b * b, weight * b * c, weight * b * d,
+            weight * c * c, weight * c * d,
+            weight * d * d,
+            weight
+        };
+    }
+
+    void add(const MeshQuadric& other) {
+        a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+        b2 += other.b2; bc += other.bc; bd += other.bd;
+        c2 += other.c2; cd += other.cd;
+        d2 += other.d2;
+        weight += other.weight;
+    }
+
+    double error(const std::array<double, 3>& point) const {
+        if (weight <= 0.0) {
+            return 0.0;
+        }
+        double x = point[0], y = point[1], z = point[2];
+        double value = a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+            + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+            + c2 * z * z + 2 * cd * z
+            + d2;
+        return std::max(value / weight, 0.0);
+    }
+
+    std::optional<std::array<double, 3>> minimum() const {
+        if (weight <= 0.0) {
+            return std::nullopt;
+        }
+        double scale = 1.0 / weight;
+        double m00 = a2 * scale, m01 = ab * scale, m02 = ac * scale;
+        double m11 = b2 * scale, m12 = bc * scale, m22 = c2 * scale;
+        double c0 = m11 * m22 - m12 * m12;
+        double c1 = m02 * m12 - m01 * m22;
+        double c2_ = m01 * m12 - m02 * m11;
+        double determinant = m00 * c0 + m01 * c1 + m02 * c2_;
+        if (std::abs(determinant) < QUADRIC_SINGULAR_DETERMINANT) {
+            return std::nullopt;
+        }
+        double r0 = -ad * scale, r1 = -bd * scale, r2 = -cd * scale;
+        return std::array<double, 3>{
+            (c0 * r0 + c1 * r1 + c2_ * r2) / determinant,
+            (c1 * r0 + (m00 * m22 - m02 * m02) * r1 + (m01 * m02 - m00 * m12) * r2) / determinant,
+            (c2_ * r0 + (m01 * m02 - m00 * m12) * r1 + (m00 * m11 - m01 * m01) * r2) / determinant
+        };
+    }
+};
+
+struct SimplifiedMesh {
+    MeshData mesh;
+    float error;
+};
+
+struct LodOptions {
+    std::vector<float> ratios = {0.5f, 0.25f, 0.125f};
+    float error_per_distance = 0.001f;
+    float max_error = std::numeric_limits<float>::max();
+};
+
+struct MeshLodChain {
+    std::vector<MeshData> levels_;
+    std::vector<float> errors_;
+    std::vector<float> distances_;
+
+    size_t byte_size() const {
+        size_t bytes = 0;
+        for (const auto& level : levels_) {
+            bytes += level.byte_size();
+        }
+        return bytes;
+    }
+
+    uint64_t content_hash() const {
+        uint64_t hash = cask::hash_vector(distances_);
+        for (const auto& level : levels_) {
+            hash = cask::hash_bytes(&hash, sizeof(hash), level.content_hash());
+        }
+        return hash;
+    }
+
+    void write_blob(cask::BlobWriter& writer) const {
+        writer.value<uint64_t>(levels_.size());
+        for (const auto& level : levels_) {
+            level.write_blob(writer);
+        }
+        writer.array(errors_);
+        writer.array(distances_);
+    }
+
+    static MeshLodChain read_blob(cask::BlobReader& reader) {
+        MeshLodChain chain;
+        uint64_t count = reader.value<uint64_t>();
+        for (uint64_t index = 0; index < count; ++index) {
+            chain.levels_.push_back(MeshData::read_blob(reader));
+        }
+        reader.array(chain.errors_);
+        reader.array(chain.distances_);
+        return chain;
+    }
+
+    bool operator==(const MeshLodChain&) const = default;
+};
+
+inline std::array<double, 3> vertex_position(std::span<const float> positions, uint32_t vertex) {
+    return {positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2]};
+}
+
+inline std::array<double, 3> sub3(const std::array<double, 3>& left, const std::array<double, 3>& right) {
+    return {left[0] - right[0], left[1] - right[1], left[2] - right[2]};
+}
+
+inline std::array<double, 3> cross3(const std::array<double, 3>& left, const std::array<double, 3>& right) {
+    return {
+        left[1] * right[2] - left[2] * right[1],
+        left[2] * right[0] - left[0] * right[2],
+        left[0] * right[1] - left[1] * right[0]
+    };
+}
+
+inline double dot3(const std::array<double, 3>& left, const std::array<double, 3>& right) {
+    return left[0] * right[0] + left[1] * right[1] + left[2] * right[2];
+}
+
+inline std::vector<MeshQuadric> vertex_quadrics(std::span<const float> positions, const std::vector<uint32_t>& indices) {
+    std::vector<MeshQuadric> quadrics(positions.size() / 3);
+    std::vector<uint64_t> edges;
+    edges.reserve(indices.size());
+
+    for (size_t index = 0; index < indices.size(); index += 3) {
+        auto p0 = vertex_position(positions, indices[index]);
+        auto normal = cross3(sub3(vertex_position(positions, indices[index + 1]), p0), sub3(vertex_position(positions, indices[index + 2]), p0));
+        double length = std::sqrt(dot3(normal, normal));
+        if (length == 0.0) {
+            continue;
+        }
+        double area = length * 0.5;
+        auto face = MeshQuadric::plane(normal[0] / length, normal[1] / length, normal[2] / length, -dot3(normal, p0) / length, area);
+        for (size_t corner = 0; corner < 3; ++corner) {
+            uint32_t from = indices[index + corner];
+            uint32_t to = indices[index + (corner + 1) % 3];
+            quadrics[from].add(face);
+            edges.push_back((static_cast<uint64_t>(std::min(from, to)) << 32) | std::max(from, to));
+        }
+    }
+
+    std::sort(edges.begin(), edges.end());
+    for (size_t index = 0; index < indices.size(); index += 3) {
+        auto p0 = vertex_position(positions, indices[index]);
+        auto normal = cross3(sub3(vertex_position(positions, indices[index + 1]), p0), sub3(vertex_position(positions, indices[index + 2]), p0));
+        if (dot3(normal, normal) == 0.0) {
+            continue;
+        }
+        for (size_t corner = 0; corner < 3; ++corner) {
+            uint32_t from = indices[index + corner];
+            uint32_t to = indices[index + (corner + 1) % 3];
+            uint64_t key = (static_cast<uint64_t>(std::min(from, to)) << 32) | std::max(from, to);
+            auto range = std::equal_range(edges.begin(), edges.end(), key);
+            if (range.second - range.first != 1) {
+                continue;
+            }
+            auto start = vertex_position(positions, from);
+            auto edge = sub3(vertex_position(positions, to), start);
+            auto border = cross3(edge, normal);
+            double length = std::sqrt(dot3(border, border));
+            if (length == 0.0) {
+                continue;
+            }
+            double edge_length = std::sqrt(dot3(edge, edge));
+            auto constraint = MeshQuadric::plane(border[0] / length, border[1] / length, border[2] / length, -dot3(border, start) / length, BORDER_QUADRIC_WEIGHT * edge_length * edge_length);
+            quadrics[from].add(constraint);
+            quadrics[to].add(constraint);
+        }
+    }
+    return quadrics;
+}
+
+inline bool collapse_flips(std::span<const float> positions, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& adjacency, uint32_t from, uint32_t to, const std::array<double, 3>& target) {
+    for (uint32_t moving : {from, to}) {
+        uint32_t other = moving == from ? to : from;
+        for (uint32_t slot = offsets[moving]; slot < offsets[moving + 1]; ++slot) {
+            const uint32_t* triangle = indices.data() + adjacency[slot] * 3;
+            if (triangle[0] == other || triangle[1] == other || triangle[2] == other) {
+                continue;
+            }
+            std::array<std::array<double, 3>, 3> corners;
+            std::array<std::array<double, 3>, 3> moved;
+            for (size_t corner = 0; corner < 3; ++corner) {
+                corners[corner] = vertex_position(positions, triangle[corner]);
+                moved[corner] = triangle[corner] == moving ? target : corners[corner];
+            }
+            auto before = cross3(sub3(corners[1], corners[0]), sub3(corners[2], corners[0]));
+            auto after = cross3(sub3(moved[1], moved[0]), sub3(moved[2], moved[0]));
+            if (dot3(before, after) <= 0.0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// The quadric minimum when the combined quadric is well conditioned and the minimum stays near
+// the edge; otherwise the cheaper endpoint, since flat or creased regions have no unique minimum.
+inline std::pair<double, std::array<double, 3>> collapse_target(const MeshQuadric& combined, const std::array<double, 3>& first, const std::array<double, 3>& second) {
+    double to_first = combined.error(first);
+    double to_second = combined.error(second);
+    std::pair<double, std::array<double, 3>> best = to_second <= to_first ? std::pair{to_second, second} : std::pair{to_first, first};
+    if (auto optimal = combined.minimum()) {
+        auto edge = sub3(second, first);
+        std::array<double, 3> midpoint{(first[0] + second[0]) * 0.5, (first[1] + second[1]) * 0.5, (first[2] + second[2]) * 0.5};
+        auto offset = sub3(*optimal, midpoint);
+        double cost = combined.error(*optimal);
+        if (dot3(offset, offset) <= dot3(edge, edge) && cost < best.first) {
+            best = {cost, *optimal};
+        }
+    }
+    return best;
+}
+
+inline SimplifiedMesh simplify_mesh(const MeshData& mesh, size_t target_index_count, float max_error = std::numeric_limits<float>::max()) {
+    struct Collapse {
+        double cost;
+        uint32_t from;
+        uint32_t to;
+        std::array<double, 3> position;
+    };
+
+    auto source_positions = mesh.positions();
+    std::vector<float> positions(source_positions.begin(), source_positions.end());
+    auto indices = mesh.indices();
+    auto quadrics = vertex_quadrics(positions, indices);
+    target_index_count = std::max<size_t>(target_index_count, 3);
+    size_t vertex_count = mesh.vertex_count();
+    double max_cost = static_cast<double>(max_error) * max_error;
+    double reached = 0.0;
+
+    std::vector<uint32_t> offsets(vertex_count + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<bool> locked(vertex_count);
+    std::vector<uint32_t> remap(vertex_count);
+
+    while (indices.size() > target_index_count) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (uint32_t vertex : indices) {
+            offsets[vertex + 1]++;
+        }
+        for (size_t vertex = 0; vertex < vertex_count; ++vertex) {
+            offsets[vertex + 1] += offsets[vertex];
+        }
+        adjacency.resize(indices.size());
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t index = 0; index < indices.size(); ++index) {
+            adjacency[fill[indices[index]]++] = static_cast<uint32_t>(index / 3);
+        }
+
+        collapses.clear();
+        for (size_t index = 0; index < indices.size(); index += 3) {
+            for (size_t corner = 0; corner < 3; ++corner) {
+                uint32_t first = std::min(indices[index + corner], indices[index + (corner + 1) % 3]);
+                uint32_t second = std::max(indices[index + corner], indices[index + (corner + 1) % 3]);
+                MeshQuadric combined = quadrics[first];
+                combined.add(quadrics[second]);
+                auto [cost, position] = collapse_target(combined, vertex_position(positions, first), vertex_position(positions, second));
+                collapses.push_back(Collapse{cost, first, second, position});
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& left, const Collapse& right) {
+            return left.cost < right.cost;
+        });
+
+        size_t budget = (indices.size() - target_index_count + 5) / 6;
+        size_t applied = 0;
+        double pass_reached = reached;
+        std::fill(locked.begin(), locked.end(), false);
+        for (uint32_t vertex = 0; vertex < vertex_count; ++vertex) {
+            remap[vertex] = vertex;
+        }
+        for (const auto& collapse : collapses) {
+            if (applied == budget || collapse.cost > max_cost) {
+                break;
+            }
+            if (locked[collapse.from] || locked[collapse.to]) {
+                continue;
+            }
+            if (collapse_flips(positions, indices, offsets, adjacency, collapse.from, collapse.to, collapse.position)) {
+                continue;
+            }
+            remap[collapse.from] = collapse.to;
+            quadrics[collapse.to].add(quadrics[collapse.from]);
+            for (size_t axis = 0; axis < 3; ++axis) {
+                positions[collapse.to * 3 + axis] = static_cast<float>(collapse.position[axis]);
+            }
+            for (uint32_t vertex : {collapse.from, collapse.to}) {
+                for (uint32_t slot = offsets[vertex]; slot < offsets[vertex + 1]; ++slot) {
+                    const uint32_t* triangle = indices.data() + adjacency[slot] * 3;
+                    locked[triangle[0]] = locked[triangle[1]] = locked[triangle[2]] = true;
+                }
+            }
+            pass_reached = std::max(pass_reached, collapse.cost);
+            applied++;
+        }
+        if (applied == 0) {
+            break;
+        }
+
+        size_t kept = 0;
+        for (size_t index = 0; index < indices.size(); index += 3) {
+            uint32_t a = remap[indices[index]];
+            uint32_t b = remap[indices[index + 1]];
+            uint32_t c = remap[indices[index + 2]];
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            indices[kept++] = a;
+            indices[kept++] = b;
+            indices[kept++] = c;
+        }
+        if (kept == 0) {
+            break;
+        }
+        indices.resize(kept);
+        reached = pass_reached;
+    }
+
+    std::vector<uint32_t> identity(vertex_count);
+    for (uint32_t vertex = 0; vertex < vertex_count; ++vertex) {
+        identity[vertex] = vertex;
+    }
+    MeshData simplified = optimize_vertex_fetch(remap_mesh(mesh, positions, identity, indices));
+    return SimplifiedMesh{std::move(simplified), static_cast<float>(std::sqrt(reached))};
+}
+
+inline MeshLodChain build_lod_chain(const MeshData& source, const LodOptions& options = {}) {
+    MeshLodChain chain;
+    chain.levels_.push_back(source);
+    chain.errors_.push_back(0.0f);
+    chain.distances_.push_back(0.0f);
+
+    for (float ratio : options.ratios) {
+        size_t triangles = static_cast<size_t>(static_cast<float>(source.index_count() / 3) * ratio);
+        size_t target = std::max<size_t>(triangles, 1) * 3;
+        const MeshData& previous = chain.levels_.back();
+        if (target >= previous.index_count()) {
+            continue;
+        }
+        auto simplified = simplify_mesh(previous, target, options.max_error);
+        if (simplified.mesh.index_count() >= previous.index_count()) {
+            break;
+        }
+        float error = std::max(chain.errors_.back(), simplified.error);
+        chain.levels_.push_back(std::move(simplified.mesh));
+        chain.errors_.push_back(error);
+        chain.distances_.push_back(std::max(chain.distances_.back(), error / options.error_per_distance));
+    }
+    return chain;
+}
+
+inline size_t select_lod(const MeshLodChain& chain, float distance) {
+    auto found = std::upper_bound(chain.distances_.begin(), chain.distances_.end(), distance);
+    return static_cast<size_t>(std::max<std::ptrdiff_t>(found - chain.distances_.begin() - 1, 0));
+}
+
+inline const MeshData& lod_for_distance(const MeshLodChain& chain, float distance) {
+    return chain.levels_[select_lod(chain, distance)];
+}
+
+inline cask::ResourceLoaderRegistry<MeshLodChain>::LoaderFn lod_chain_loader(cask::ResourceLoaderRegistry<MeshData>::LoaderFn mesh_loader, LodOptions options = {}) {
+    return [mesh_loader = std::move(mesh_loader), options = std::move(options)](const nlohmann::json& loader_spec) {
+        return build_lod_chain(mesh_loader(loader_spec), options);
+    };
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cask/resource/resource_descriptor.hpp>
+
+struct MeshLodChain;
+
+CASK_RESOURCE_DESCRIPTOR(MeshLodChain, "MeshLod")
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <cask/resource/content_hash.hpp>
+#include <cask/resource/mesh_data.hpp>
+
+inline constexpr uint32_t DEFAULT_VERTEX_CACHE_SIZE = 16;
+
+struct MeshOptimizeOptions {
+    bool weld = true;
+    bool reorder_cache = true;
+    bool reorder_fetch = true;
+    uint32_t cache_size = DEFAULT_VERTEX_CACHE_SIZE;
+};
+
+struct MeshOptimization {
+    MeshData mesh;
+    float acmr_before;
+    float acmr_after;
+    size_t vertices_before;
+    size_t vertices_after;
+};
+
+inline float compute_acmr(const std::vector<uint32_t>& indices, size_t vertex_count, uint32_t cache_size = DEFAULT_VERTEX_CACHE_SIZE) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+    std::vector<int64_t> inserted(vertex_count, std::numeric_limits<int64_t>::min() / 2);
+    int64_t misses = 0;
+    for (uint32_t vertex : indices) {
+        if (misses - inserted[vertex] > static_cast<int64_t>(cache_size)) {
+            inserted[vertex] = misses;
+            misses++;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+inline cask::PayloadVector<float> gather_attribute(std::span<const float> values, const std::vector<uint32_t>& sources, size_t components) {
+    if (values.empty()) {
+        return {};
+    }
+    cask::PayloadVector<float> gathered(sources.size() * components);
+    for (size_t target = 0; target < sources.size(); ++target) {
+        std::memcpy(gathered.data() + target * components, values.data() + sources[target] * components, components * sizeof(float));
+    }
+    return gathered;
+}
+
+inline MeshData remap_mesh(const MeshData& mesh, std::span<const float> positions, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& indices) {
+    MeshData remapped(
+        gather_attribute(positions, sources, 3),
+        cask::PayloadVector<uint32_t>(indices.begin(), indices.end()),
+        gather_attribute(mesh.normals(), sources, 3),
+        gather_attribute(mesh.uvs(), sources, 2),
+        mesh.format()
+    );
+    if (mesh.has_vertex_buffer()) {
+        remapped.interleave(mesh.vertex_layout());
+    }
+    return remapped;
+}
+
+inline MeshData remap_mesh(const MeshData& mesh, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& indices) {
+    return remap_mesh(mesh, mesh.positions(), sources, indices);
+}
+
+struct WeldAttributes {
+    std::span<const float> positions;
+    std::vector<float> normals;
+    std::vector<float> uvs;
+};
+
+inline bool same_vertex(const WeldAttributes& attributes, uint32_t first, uint32_t second) {
+    auto same = [first, second](std::span<const float> values, size_t components) {
+        return values.empty() || std::memcmp(values.data() + first * components, values.data() + second * components, components * sizeof(float)) == 0;
+    };
+    return same(attributes.positions, 3) && same(attributes.normals, 3) && same(attributes.uvs, 2);
+}
+
+inline uint64_t vertex_hash(const WeldAttributes& attributes, uint32_t vertex) {
+    uint64_t hash = cask::hash_bytes(attributes.positions.data() + vertex * 3, 3 * sizeof(float));
+    if (!attributes.normals.empty()) {
+        hash = cask::hash_bytes(attributes.normals.data() + vertex * 3, 3 * sizeof(float), hash);
+    }
+    if (!attributes.uvs.empty()) {
+        hash = cask::hash_bytes(attributes.uvs.data() + vertex * 2, 2 * sizeof(float), hash);
+    }
+    return hash;
+}
+
+inline MeshData weld_vertices(const MeshData& mesh) {
+    constexpr uint32_t EMPTY = std::numeric_limits<uint32_t>::max();
+    size_t vertex_count = mesh.vertex_count();
+    size_t capacity = std::bit_ceil(vertex_count * 2);
+    size_t mask = capacity - 1;
+    WeldAttributes attributes{mesh.positions(), mesh.normals(), mesh.uvs()};
+
+    std::vector<uint32_t> table(capacity, EMPTY);
+    std::vector<uint32_t> sources;
+    std::vector<uint32_t> remap(vertex_count);
+
+    for (uint32_t vertex = 0; vertex < vertex_count; ++vertex) {
+        size_t slot = static_cast<size_t>(vertex_hash(attributes, vertex)) & mask;
+        while (true) {
+            uint32_t welded = table[slot];
+            if (welded == EMPTY) {
+                welded = static_cast<uint32_t>(sources.size());
+                table[slot] = welded;
+                sources.push_back(vertex);
+                remap[vertex] = welded;
+                break;
+            }
+            if (same_vertex(attributes, sources[welded], vertex)) {
+                remap[vertex] = welded;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    auto indices = mesh.indices();
+    for (auto& index : indices) {
+        index = remap[index];
+    }
+    return remap_mesh(mesh, sources, indices);
+}
+
+inline std::vector<uint32_t> optimize_vertex_cache(const std::vector<uint32_t>& indices, size_t vertex_count, uint32_t cache_size = DEFAULT_VERTEX_CACHE_SIZE) {
+    size_t triangle_count = indices.size() / 3;
+
+    std::vector<uint32_t> live(vertex_count, 0);
+    for (uint32_t vertex : indices) {
+        live[vertex]++;
+    }
+    std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+    for (size_t vertex = 0; vertex < vertex_count; ++vertex) {
+        adjacency_offsets[vertex + 1] = adjacency_offsets[vertex] + live[vertex];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+    for (size_t triangle = 0; triangle < triangle_count; ++triangle) {
+        for (size_t corner = 0; corner < 3; ++corner) {
+            adjacency[fill[indices[triangle * 3 + corner]]++] = static_cast<uint32_t>(triangle);
+        }
+    }
+
+    std::vector<uint32_t> cache_time(vertex_count, 0);
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<uint32_t> dead_ends;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    output.reserve(triangle_count * 3);
+
+    uint32_t timestamp = cache_size + 1;
+    size_t cursor = 0;
+    int64_t fanning = vertex_count > 0 ? 0 : -1;
+
+    while (fanning >= 0) {
+        candidates.clear();
+        auto vertex = static_cast<uint32_t>(fanning);
+        for (uint32_t slot = adjacency_offsets[vertex]; slot < adjacency_offsets[vertex + 1]; ++slot) {
+            uint32_t triangle = adjacency[slot];
+            if (emitted[triangle]) {
+                continue;
+            }
+            for (size_t corner = 0; corner < 3; ++corner) {
+                uint32_t corner_vertex = indices[triangle * 3 + corner];
+                output.push_back(corner_vertex);
+                dead_ends.push_back(corner_vertex);
+                candidates.push_back(corner_vertex);
+                live[corner_vertex]--;
+                if (timestamp - cache_time[corner_vertex] > cache_size) {
+                    cache_time[corner_vertex] = timestamp++;
+                }
+            }
+            emitted[triangle] = true;
+        }
+
+        fanning = -1;
+        int64_t best_priority = -1;
+        for (uint32_t candidate : candidates) {
+            if (live[candidate] == 0) {
+                continue;
+            }
+            int64_t priority = 0;
+            if (timestamp - cache_time[candidate] + 2 * live[candidate] <= cache_size) {
+                priority = timestamp - cache_time[candidate];
+            }
+            if (priority > best_priority) {
+                best_priority = priority;
+                fanning = candidate;
+            }
+        }
+
+        while (fanning < 0 && !dead_ends.empty()) {
+            uint32_t dead_end = dead_ends.back();
+            dead_ends.pop_back();
+            if (live[dead_end] > 0) {
+                fanning = dead_end;
+            }
+        }
+        while (fanning < 0 && cursor < vertex_count) {
+            if (live[cursor] > 0) {
+                fanning = static_cast<int64_t>(cursor);
+            }
+            cursor++;
+        }
+    }
+
+    return output;
+}
+
+inline MeshData optimize_vertex_fetch(const MeshData& mesh) {
+    constexpr uint32_t UNSEEN = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(mesh.vertex_count(), UNSEEN);
+    std::vector<uint32_t> sources;
+    auto indices = mesh.indices();
+
+    for (auto& index : indices) {
+        if (remap[index] == UNSEEN) {
+            remap[index] = static_cast<uint32_t>(sources.size());
+            sources.push_back(index);
+        }
+        index = remap[index];
+    }
+    return remap_mesh(mesh, sources, indices);
+}
+
+inline MeshOptimization optimize_mesh(const MeshData& mesh, const MeshOptimizeOptions& options = {}) {
+    float acmr_before = compute_acmr(mesh.indices(), mesh.vertex_count(), options.cache_size);
+    MeshData optimized = options.weld ? weld_vertices(mesh) : mesh;
+
+    if (options.reorder_cache) {
+        auto indices = optimize_vertex_cache(optimized.indices(), optimized.vertex_count(), options.cache_size);
+        std::vector<uint32_t> identity(optimized.vertex_count());
+        for (uint32_t vertex = 0; vertex < identity.size(); ++vertex) {
+            identity[vertex] = vertex;
+        }
+        optimized = remap_mesh(optimized, identity, indices);
+    }
+    if (options.reorder_fetch) {
+        optimized = optimize_vertex_fetch(optimized);
+    }
+
+    float acmr_after = compute_acmr(optimized.indices(), optimized.vertex_count(), options.cache_size);
+    size_t vertices_after = optimized.vertex_count();
+    return MeshOptimization{std::move(optimized), acmr_before, acmr_after, mesh.vertex_count(), vertices_after};
+}
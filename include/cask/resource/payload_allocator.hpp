@@ -0,0 +1,197 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__APPLE__) || defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace cask {
+
+inline constexpr size_t PAYLOAD_ALIGNMENT = 64;
+inline constexpr size_t LARGE_PAYLOAD_BYTES = 2 * 1024 * 1024;
+inline constexpr size_t DEFAULT_PAYLOAD_CACHE_BYTES = 256 * 1024 * 1024;
+
+// Sizes up to 64 bytes share one class; above that each power of two is split
+// into four classes, so rounding wastes at most a quarter of the request.
+inline size_t payload_size_class(size_t bytes) {
+    if (bytes <= PAYLOAD_ALIGNMENT) {
+        return PAYLOAD_ALIGNMENT;
+    }
+    size_t step = std::bit_floor(bytes - 1) / 4;
+    return (bytes + step - 1) / step * step;
+}
+
+struct PayloadPoolStats {
+    size_t live_bytes = 0;
+    size_t cached_bytes = 0;
+    size_t reused_blocks = 0;
+};
+
+struct PayloadPool {
+    std::mutex mutex_;
+    std::unordered_map<size_t, std::vector<void*>> free_blocks_;
+    PayloadPoolStats stats_;
+    size_t cache_limit_;
+    bool huge_pages_ = false;
+
+    explicit PayloadPool(size_t cache_limit = DEFAULT_PAYLOAD_CACHE_BYTES) : cache_limit_(cache_limit) {}
+
+    PayloadPool(const PayloadPool&) = delete;
+    PayloadPool& operator=(const PayloadPool&) = delete;
+
+    ~PayloadPool() {
+        trim();
+    }
+
+    static void* allocate_block(size_t size, bool huge_pages) {
+#if defined(__APPLE__) || defined(__linux__)
+        if (size >= LARGE_PAYLOAD_BYTES) {
+            void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+#if defined(MADV_HUGEPAGE)
+            if (huge_pages) {
+                madvise(mapped, size, MADV_HUGEPAGE);
+            }
+#endif
+            return mapped;
+        }
+#endif
+        (void)huge_pages;
+        return ::operator new(size, std::align_val_t{PAYLOAD_ALIGNMENT});
+    }
+
+    static void release_block(void* block, size_t size) {
+#if defined(__APPLE__) || defined(__linux__)
+        if (size >= LARGE_PAYLOAD_BYTES) {
+            munmap(block, size);
+            return;
+        }
+#endif
+        ::operator delete(block, std::align_val_t{PAYLOAD_ALIGNMENT});
+    }
+
+    void* allocate(size_t bytes) {
+        size_t size = payload_size_class(bytes);
+        bool huge_pages;
+        {
+            std::lock_guard lock(mutex_);
+            stats_.live_bytes += size;
+            auto found = free_blocks_.find(size);
+            if (found != free_blocks_.end() && !found->second.empty()) {
+                void* block = found->second.back();
+                found->second.pop_back();
+                stats_.cached_bytes -= size;
+                stats_.reused_blocks++;
+                return block;
+            }
+            huge_pages = huge_pages_;
+        }
+        try {
+            return allocate_block(size, huge_pages);
+        } catch (...) {
+            std::lock_guard lock(mutex_);
+            stats_.live_bytes -= size;
+            throw;
+        }
+    }
+
+    void deallocate(void* block, size_t bytes) {
+        size_t size = payload_size_class(bytes);
+        {
+            std::lock_guard lock(mutex_);
+            stats_.live_bytes -= size;
+            if (stats_.cached_bytes + size <= cache_limit_) {
+                try {
+                    free_blocks_[size].push_back(block);
+                    stats_.cached_bytes += size;
+                    return;
+                } catch (const std::bad_alloc&) {
+                }
+            }
+        }
+        release_block(block, size);
+    }
+
+    void trim() {
+        std::unordered_map<size_t, std::vector<void*>> released;
+        {
+            std::lock_guard lock(mutex_);
+            released.swap(free_blocks_);
+            stats_.cached_bytes = 0;
+        }
+        for (auto& [size, blocks] : released) {
+            for (void* block : blocks) {
+                release_block(block, size);
+            }
+        }
+    }
+
+    void set_cache_limit(size_t cache_limit) {
+        {
+            std::lock_guard lock(mutex_);
+            cache_limit_ = cache_limit;
+            if (stats_.cached_bytes <= cache_limit_) {
+                return;
+            }
+        }
+        trim();
+    }
+
+    void use_huge_pages(bool enabled) {
+        std::lock_guard lock(mutex_);
+        huge_pages_ = enabled;
+    }
+
+    PayloadPoolStats stats() {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+};
+
+// Intentionally leaked so payloads owned by other statics can still be freed
+// during shutdown, whatever order the statics are destroyed in.
+inline PayloadPool& payload_pool() {
+    static PayloadPool* pool = new PayloadPool();
+    return *pool;
+}
+
+template<typename T>
+struct PayloadAllocator {
+    using value_type = T;
+
+    static_assert(alignof(T) <= PAYLOAD_ALIGNMENT, "payload types must not need more than 64-byte alignment");
+
+    PayloadAllocator() = default;
+
+    template<typename U>
+    PayloadAllocator(const PayloadAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(payload_pool().allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        payload_pool().deallocate(pointer, count * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PayloadAllocator<U>&) const noexcept { return true; }
+};
+
+template<typename T>
+using PayloadVector = std::vector<T, PayloadAllocator<T>>;
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace cask {
+
+inline constexpr size_t BLOB_ALIGNMENT = 64;
+
+inline size_t align_blob_offset(size_t offset) {
+    return (offset + BLOB_ALIGNMENT - 1) & ~(BLOB_ALIGNMENT - 1);
+}
+
+struct BlobWriter {
+    std::vector<std::byte> bytes_;
+
+    template<typename T>
+    void value(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "blob values must be trivially copyable");
+        size_t offset = bytes_.size();
+        bytes_.resize(offset + sizeof(T));
+        std::memcpy(bytes_.data() + offset, &value, sizeof(T));
+    }
+
+    template<typename T, typename Allocator>
+    void array(const std::vector<T, Allocator>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "blob arrays must be trivially copyable");
+        value<uint64_t>(values.size());
+        size_t offset = align_blob_offset(bytes_.size());
+        bytes_.resize(offset + values.size() * sizeof(T));
+        if (!values.empty()) {
+            std::memcpy(bytes_.data() + offset, values.data(), values.size() * sizeof(T));
+        }
+    }
+};
+
+struct BlobReader {
+    std::span<const std::byte> bytes_;
+    size_t offset_ = 0;
+
+    explicit BlobReader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+    void require(size_t offset, size_t size) const {
+        if (offset > bytes_.size() || size > bytes_.size() - offset) {
+            throw std::runtime_error("resource blob is truncated");
+        }
+    }
+
+    template<typename T>
+    T value() {
+        static_assert(std::is_trivially_copyable_v<T>, "blob values must be trivially copyable");
+        require(offset_, sizeof(T));
+        T result;
+        std::memcpy(&result, bytes_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return result;
+    }
+
+    template<typename T, typename Allocator>
+    void array(std::vector<T, Allocator>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "blob arrays must be trivially copyable");
+        uint64_t count = value<uint64_t>();
+        size_t offset = align_blob_offset(offset_);
+        if (count > bytes_.size() / sizeof(T)) {
+            throw std::runtime_error("resource blob is truncated");
+        }
+        require(offset, static_cast<size_t>(count) * sizeof(T));
+        values.resize(static_cast<size_t>(count));
+        if (count != 0) {
+            std::memcpy(values.data(), bytes_.data() + offset, static_cast<size_t>(count) * sizeof(T));
+        }
+        offset_ = offset + static_cast<size_t>(count) * sizeof(T);
+    }
+};
+
+}
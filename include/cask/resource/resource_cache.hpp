@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cask/platform/mapped_file.hpp>
+#include <cask/resource/content_hash.hpp>
+#include <cask/resource/resource_blob.hpp>
+#include <cask/resource/resource_descriptor.hpp>
+#include <cask/resource/resource_loader_registry.hpp>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cask {
+
+inline constexpr uint32_t RESOURCE_CACHE_MAGIC = 0x53455243;
+inline constexpr uint32_t RESOURCE_CACHE_VERSION = 2;
+
+struct ResourceCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t payload_offset;
+    uint64_t payload_size;
+};
+
+template<typename Resource>
+concept BlobResource = requires(const Resource& resource, BlobWriter& writer, BlobReader& reader) {
+    resource.write_blob(writer);
+    { Resource::read_blob(reader) } -> std::same_as<Resource>;
+};
+
+struct ResourceCache {
+    std::filesystem::path directory_;
+    std::string root_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+
+    explicit ResourceCache(std::filesystem::path directory, std::string root = "")
+        : directory_(std::move(directory)), root_(std::move(root)) {
+        std::filesystem::create_directories(directory_);
+    }
+
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    std::string resolve(const std::string& path) const {
+        return root_.empty() ? path : root_ + "/" + path;
+    }
+
+    std::optional<uint64_t> key(const std::string& type, const nlohmann::json& loader_spec) const {
+        uint64_t hash = hash_bytes(type.data(), type.size(), RESOURCE_CACHE_VERSION);
+        std::string spec = loader_spec.dump();
+        hash = hash_bytes(spec.data(), spec.size(), hash);
+
+        auto path = loader_spec.find("path");
+        if (path != loader_spec.end() && path->is_string()) {
+            std::filesystem::path source = resolve(path->get<std::string>());
+            std::error_code time_error;
+            std::error_code size_error;
+            auto modified = std::filesystem::last_write_time(source, time_error);
+            auto size = std::filesystem::file_size(source, size_error);
+            if (time_error || size_error) {
+                return std::nullopt;
+            }
+            uint64_t stamp[] = {static_cast<uint64_t>(modified.time_since_epoch().count()), static_cast<uint64_t>(size)};
+            hash = hash_bytes(stamp, sizeof(stamp), hash);
+        }
+        return hash;
+    }
+
+    std::filesystem::path blob_path(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.blob", static_cast<unsigned long long>(key));
+        return directory_ / name;
+    }
+
+    template<BlobResource Resource>
+    std::optional<Resource> read(uint64_t key) {
+        auto path = blob_path(key);
+        if (!std::filesystem::exists(path)) {
+            return std::nullopt;
+        }
+        try {
+            MappedFile mapped(path.string());
+            auto bytes = mapped.bytes();
+            ResourceCacheHeader header{};
+            if (bytes.size() < sizeof(header)) {
+                throw std::runtime_error("resource cache entry is smaller than its header");
+            }
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            if (header.magic != RESOURCE_CACHE_MAGIC || header.version != RESOURCE_CACHE_VERSION || header.key != key) {
+                throw std::runtime_error("resource cache entry does not match its key");
+            }
+            if (header.payload_offset > bytes.size() || header.payload_size > bytes.size() - header.payload_offset) {
+                throw std::runtime_error("resource cache entry is truncated");
+            }
+            BlobReader reader(bytes.subspan(header.payload_offset, header.payload_size));
+            return Resource::read_blob(reader);
+        } catch (const std::exception&) {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            return std::nullopt;
+        }
+    }
+
+    template<BlobResource Resource>
+    bool write(uint64_t key, const Resource& resource) {
+        BlobWriter writer;
+        resource.write_blob(writer);
+        ResourceCacheHeader header{
+            RESOURCE_CACHE_MAGIC,
+            RESOURCE_CACHE_VERSION,
+            key,
+            align_blob_offset(sizeof(ResourceCacheHeader)),
+            writer.bytes_.size()
+        };
+
+        auto path = blob_path(key);
+        auto staged = path;
+        staged += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream file(staged, std::ios::binary | std::ios::trunc);
+            std::vector<char> padding(header.payload_offset - sizeof(header));
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+            file.write(reinterpret_cast<const char*>(writer.bytes_.data()), static_cast<std::streamsize>(writer.bytes_.size()));
+            file.close();
+            if (!file) {
+                std::error_code error;
+                std::filesystem::remove(staged, error);
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(staged, path, error);
+        if (error) {
+            std::filesystem::remove(staged, error);
+            return false;
+        }
+        return true;
+    }
+};
+
+template<BlobResource Resource>
+typename ResourceLoaderRegistry<Resource>::LoaderFn cached_loader(ResourceCache& cache, typename ResourceLoaderRegistry<Resource>::LoaderFn loader) {
+    return [&cache, loader = std::move(loader)](const nlohmann::json& loader_spec) -> Resource {
+        auto key = cache.key(ResourceDescriptor<Resource>::store, loader_spec);
+        if (!key) {
+            return loader(loader_spec);
+        }
+        if (auto cached = cache.read<Resource>(*key)) {
+            cache.hits_++;
+            return std::move(*cached);
+        }
+        cache.misses_++;
+        Resource loaded = loader(loader_spec);
+        cache.write(*key, loaded);
+        return loaded;
+    };
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cask/ecs/component_store.hpp>
+#include <cask/resource/resource_handle.hpp>
+#include <cask/resource/resource_loader_registry.hpp>
+#include <cask/resource/resource_sources.hpp>
+#include <cask/resource/resource_store.hpp>
+#include <cstdint>
+#include <string>
+
+namespace cask {
+
+template<typename T>
+void insert_resource(ComponentStore<ResourceHandle<T>>& components, ResourceStore<T>& resources, uint32_t entity, ResourceHandle<T> handle) {
+    resources.acquire(handle);
+    if (components.has(entity)) {
+        auto& current = components.modify(entity);
+        resources.release(current);
+        current = handle;
+        return;
+    }
+    components.insert(entity, handle);
+}
+
+template<typename T>
+void remove_resource(ComponentStore<ResourceHandle<T>>& components, ResourceStore<T>& resources, uint32_t entity) {
+    if (!components.has(entity)) {
+        return;
+    }
+    resources.release(components.get(entity));
+    components.remove(entity);
+}
+
+template<typename T>
+struct ResourceComponents {
+    ComponentStore<ResourceHandle<T>>* components_;
+    ResourceStore<T>* resources_;
+};
+
+template<typename T>
+void remove_resource_component(void* ptr, uint32_t entity) {
+    auto* bound = static_cast<ResourceComponents<T>*>(ptr);
+    remove_resource(*bound->components_, *bound->resources_, entity);
+}
+
+template<typename T>
+typename ResourceStore<T>::Reloader source_reloader(const ResourceSources<T>& sources, const ResourceLoaderRegistry<T>& loaders) {
+    return [&sources, &loaders](const std::string& key) {
+        const auto& loader_spec = sources.entries.at(key);
+        return loaders.get(loader_spec.at("loader").template get_ref<const std::string&>())(loader_spec);
+    };
+}
+
+}
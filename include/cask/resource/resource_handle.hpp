@@ -5,4 +5,11 @@
 template<typename Tag>
 struct ResourceHandle {
     uint32_t value;
+    uint32_t generation = 0;
 };
+
+template<typename T>
+inline constexpr bool is_resource_handle_v = false;
+
+template<typename Tag>
+inline constexpr bool is_resource_handle_v<ResourceHandle<Tag>> = true;
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cask/container/string_map.hpp>
+#include <cstdint>
 #include <functional>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
 namespace cask {
 
@@ -12,22 +14,30 @@ template<typename Resource>
 struct ResourceLoaderRegistry {
     using LoaderFn = std::function<Resource(const nlohmann::json&)>;
 
-    std::unordered_map<std::string, LoaderFn> loaders_;
+    NameTable<LoaderFn> loaders_;
 
-    void add(const std::string& name, LoaderFn loader) {
-        loaders_.emplace(name, std::move(loader));
+    uint32_t add(std::string_view name, LoaderFn loader) {
+        return loaders_.add(name, std::move(loader));
     }
 
-    const LoaderFn& get(const std::string& name) const {
+    uint32_t id(std::string_view name) const {
         auto found = loaders_.find(name);
-        if (found == loaders_.end()) {
-            throw std::runtime_error("No loader registered for: " + name);
+        if (!found) {
+            throw std::runtime_error("No loader registered for: " + std::string(name));
         }
-        return found->second;
+        return *found;
     }
 
-    bool has(const std::string& name) const {
-        return loaders_.find(name) != loaders_.end();
+    const LoaderFn& get(std::string_view name) const {
+        return loaders_.at(id(name));
+    }
+
+    const LoaderFn& get(uint32_t id) const {
+        return loaders_.at(id);
+    }
+
+    bool has(std::string_view name) const {
+        return loaders_.find(name).has_value();
     }
 };
 
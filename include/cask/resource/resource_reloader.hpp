@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cask/platform/file_watcher.hpp>
+#include <cask/resource/load_batch.hpp>
+#include <cask/resource/resource_handle.hpp>
+#include <cask/resource/resource_loader_registry.hpp>
+#include <cask/resource/resource_sources.hpp>
+#include <cask/resource/resource_store.hpp>
+#include <cask/task/worker_pool.hpp>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cask {
+
+template<typename Resource>
+struct ResourceReloader {
+    struct Watched {
+        std::string key;
+        nlohmann::json loader_spec;
+    };
+
+    struct Loaded {
+        ResourceHandle<Resource> handle;
+        uint64_t generation;
+        Resource data;
+    };
+
+    ResourceStore<Resource>& store_;
+    const ResourceLoaderRegistry<Resource>& loaders_;
+    std::string root_;
+    FileWatcher watcher_;
+    std::unordered_map<std::string, std::vector<Watched>> watched_;
+    std::unordered_map<uint32_t, uint64_t> generations_;
+    LoadBatch<Loaded> batch_;
+
+    ResourceReloader(ResourceStore<Resource>& store, const ResourceLoaderRegistry<Resource>& loaders, WorkerPool& pool, std::string root = "")
+        : store_(store), loaders_(loaders), root_(std::move(root)), batch_(pool) {}
+
+    ResourceReloader(const ResourceReloader&) = delete;
+    ResourceReloader& operator=(const ResourceReloader&) = delete;
+
+    std::string resolve(const std::string& path) const {
+        return root_.empty() ? path : root_ + "/" + path;
+    }
+
+    void watch(const std::string& key, const nlohmann::json& loader_spec) {
+        auto path = loader_spec.find("path");
+        if (path == loader_spec.end() || !path->is_string()) {
+            return;
+        }
+        std::string file = FileWatcher::normalize(resolve(path->get<std::string>()));
+        watcher_.watch(file);
+        watched_[file].push_back(Watched{key, loader_spec});
+    }
+
+    void watch(const ResourceSources<Resource>& sources) {
+        for (const auto& [key, loader_spec] : sources.entries) {
+            watch(key, loader_spec);
+        }
+    }
+
+    size_t poll() {
+        size_t scheduled = 0;
+        for (const auto& file : watcher_.poll()) {
+            auto found = watched_.find(file);
+            if (found == watched_.end()) {
+                continue;
+            }
+            for (const auto& watched : found->second) {
+                auto existing = store_.find(watched.key);
+                if (!existing) {
+                    continue;
+                }
+                schedule(*existing, watched);
+                scheduled++;
+            }
+        }
+        return scheduled;
+    }
+
+    void schedule(ResourceHandle<Resource> handle, const Watched& watched) {
+        const auto& loader = loaders_.get(watched.loader_spec.at("loader").template get_ref<const std::string&>());
+        uint64_t generation = ++generations_[handle.value];
+        batch_.submit(watched.key, [&loader, handle, generation, loader_spec = watched.loader_spec] {
+            return Loaded{handle, generation, loader(loader_spec)};
+        });
+    }
+
+    size_t pending() {
+        return batch_.pending();
+    }
+
+    // Each key owns its slot, so replacing it leaves resources deduplicated with it untouched.
+    size_t commit() {
+        auto [loaded, failed] = batch_.take();
+        size_t swapped = 0;
+        for (auto& entry : loaded) {
+            if (generations_[entry.handle.value] != entry.generation || !store_.valid(entry.handle)) {
+                continue;
+            }
+            store_.replace(entry.handle, std::move(entry.data));
+            swapped++;
+        }
+        if (!failed.empty()) {
+            throw std::runtime_error(describe_load_failures("failed to reload resources", failed));
+        }
+        return swapped;
+    }
+
+    void wait() {
+        batch_.wait();
+    }
+};
+
+}
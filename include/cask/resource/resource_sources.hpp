@@ -1,10 +1,9 @@
 #pragma once
 
+#include <cask/container/string_map.hpp>
 #include <nlohmann/json.hpp>
-#include <string>
-#include <unordered_map>
 
 template<typename Resource>
 struct ResourceSources {
-    std::unordered_map<std::string, nlohmann::json> entries;
+    cask::StringMap<nlohmann::json> entries;
 };
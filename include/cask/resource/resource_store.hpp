@@ -1,39 +1,409 @@
 #pragma once
 
+#include <cask/container/string_map.hpp>
 #include <cask/resource/resource_handle.hpp>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+template<typename Resource>
+size_t resource_bytes(const Resource& resource) {
+    if constexpr (requires { resource.byte_size(); }) {
+        return resource.byte_size();
+    } else {
+        return sizeof(Resource);
+    }
+}
+
 template<typename Resource>
 struct ResourceStore {
-    std::vector<Resource> resources_;
-    std::unordered_map<std::string, uint32_t> key_to_handle_;
-    std::unordered_map<uint32_t, std::string> handle_to_key_;
+    using Reloader = std::function<Resource(const std::string&)>;
+
+    static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+    // Every key has its own slot and handle. Deduplicated keys are aliases: their slot holds no
+    // payload and points at the owner slot whose payload they share. Only owners carry bytes,
+    // sit in the LRU list and appear in the content index.
+    struct Slot {
+        uint32_t ref_count = 0;
+        uint32_t owner = NO_SLOT;
+        uint32_t pins = 0;
+        size_t bytes = 0;
+        uint32_t older = NO_SLOT;
+        uint32_t newer = NO_SLOT;
+        bool queued = false;
+        uint64_t hash = 0;
+        bool hashed = false;
+        uint32_t generation = 0;
+        std::string key;
+        std::vector<uint32_t> aliases;
+    };
+
+    std::vector<std::optional<Resource>> payloads_;
+    std::vector<Slot> slots_;
+    cask::StringMap<uint32_t> key_to_handle_;
+    std::vector<uint32_t> free_slots_;
+    uint32_t lru_oldest_ = NO_SLOT;
+    uint32_t lru_newest_ = NO_SLOT;
+    size_t resident_bytes_ = 0;
+    size_t budget_ = std::numeric_limits<size_t>::max();
+    size_t evictions_ = 0;
+    Reloader reloader_;
+    bool deduplicate_ = false;
+    std::unordered_map<uint64_t, uint32_t> hash_to_handle_;
+    size_t dedup_hits_ = 0;
+    size_t dedup_bytes_saved_ = 0;
 
-    ResourceHandle<Resource> store(const std::string& key, Resource data) {
+    ResourceHandle<Resource> store(std::string_view key, Resource data) {
         auto existing = key_to_handle_.find(key);
         if (existing != key_to_handle_.end()) {
-            return ResourceHandle<Resource>{existing->second};
+            uint32_t raw_handle = existing->second;
+            uint32_t owner = payload(raw_handle);
+            if (!payloads_[owner]) {
+                fill(owner, std::move(data));
+                trim(owner);
+            }
+            return handle(raw_handle);
+        }
+        if constexpr (requires { data.content_hash(); } && std::equality_comparable<Resource>) {
+            if (deduplicate_) {
+                uint64_t hash = data.content_hash();
+                auto found = hash_to_handle_.find(hash);
+                if (found != hash_to_handle_.end() && same_content(found->second, data)) {
+                    uint32_t owner = found->second;
+                    uint32_t raw_handle = allocate(key);
+                    slots_[raw_handle].owner = owner;
+                    slots_[owner].aliases.push_back(raw_handle);
+                    dedup_hits_++;
+                    dedup_bytes_saved_ += resource_bytes(data);
+                    return handle(raw_handle);
+                }
+                auto handle = store_unique(key, std::move(data));
+                index_content(handle.value, hash);
+                return handle;
+            }
+        }
+        return store_unique(key, std::move(data));
+    }
+
+    ResourceHandle<Resource> store_unique(std::string_view key, Resource data) {
+        uint32_t raw_handle = allocate(key);
+        fill(raw_handle, std::move(data));
+        trim(raw_handle);
+        return handle(raw_handle);
+    }
+
+    uint32_t allocate(std::string_view key) {
+        uint32_t raw_handle;
+        if (!free_slots_.empty()) {
+            raw_handle = free_slots_.back();
+            free_slots_.pop_back();
+        } else {
+            raw_handle = static_cast<uint32_t>(payloads_.size());
+            payloads_.emplace_back();
+            slots_.emplace_back();
         }
-        uint32_t raw_handle = static_cast<uint32_t>(resources_.size());
-        resources_.push_back(std::move(data));
-        key_to_handle_[key] = raw_handle;
-        handle_to_key_[raw_handle] = key;
-        return ResourceHandle<Resource>{raw_handle};
+        slots_[raw_handle].key = key;
+        key_to_handle_.insert_or_assign(slots_[raw_handle].key, raw_handle);
+        return raw_handle;
     }
 
+    ResourceHandle<Resource> handle(uint32_t raw_handle) const {
+        return ResourceHandle<Resource>{raw_handle, slots_[raw_handle].generation};
+    }
+
+    uint32_t payload(uint32_t raw_handle) const {
+        uint32_t owner = slots_[raw_handle].owner;
+        return owner == NO_SLOT ? raw_handle : owner;
+    }
+
+    std::optional<ResourceHandle<Resource>> find(std::string_view key) const {
+        auto found = key_to_handle_.find(key);
+        if (found == key_to_handle_.end()) {
+            return std::nullopt;
+        }
+        return handle(found->second);
+    }
+
+    bool valid(ResourceHandle<Resource> handle) const {
+        return handle.value < slots_.size() && slots_[handle.value].generation == handle.generation;
+    }
+
+    void check(ResourceHandle<Resource> handle) const {
+#ifndef NDEBUG
+        if (!valid(handle)) {
+            throw std::runtime_error("stale resource handle: " + std::to_string(handle.value));
+        }
+#else
+        (void)handle;
+#endif
+    }
+
+    void remove(ResourceHandle<Resource> handle) {
+        check(handle);
+        auto& slot = slots_[handle.value];
+        if (slot.ref_count != 0) {
+            throw std::runtime_error("remove of referenced resource: " + slot.key);
+        }
+        detach(handle.value);
+        if (payloads_[handle.value]) {
+            drop(handle.value);
+        }
+        unindex_content(handle.value);
+        key_to_handle_.erase(slot.key);
+        slot.key.clear();
+        slot.pins = 0;
+        slot.generation++;
+        free_slots_.push_back(handle.value);
+    }
+
+    size_t size() const {
+        return payloads_.size() - free_slots_.size();
+    }
+
+    // Replacing one key never changes the keys deduplicated with it: the slot is detached from
+    // any payload it shares before the new data is filled in.
+    void replace(ResourceHandle<Resource> handle, Resource data) {
+        check(handle);
+        detach(handle.value);
+        if (payloads_[handle.value]) {
+            drop(handle.value);
+        }
+        unindex_content(handle.value);
+        if constexpr (requires { data.content_hash(); } && std::equality_comparable<Resource>) {
+            if (deduplicate_) {
+                index_content(handle.value, data.content_hash());
+            }
+        }
+        fill(handle.value, std::move(data));
+        trim(handle.value);
+    }
+
+    // get() reloads an evicted resource but never evicts, so a reference it returns stays valid
+    // until the next store, replace, remove, release, set_budget or trim. Reloads can leave the
+    // store over budget until then; call trim() at a frame or commit point.
     Resource& get(ResourceHandle<Resource> handle) {
-        return resources_[handle.value];
+        check(handle);
+        uint32_t owner = payload(handle.value);
+        if (!payloads_[owner]) {
+            reload(owner);
+        }
+        touch(owner);
+        return *payloads_[owner];
     }
 
+    // The const overload cannot reload, so it throws for an evicted resource.
     const Resource& get(ResourceHandle<Resource> handle) const {
-        return resources_[handle.value];
+        check(handle);
+        uint32_t owner = payload(handle.value);
+        if (!payloads_[owner]) {
+            throw std::runtime_error("resource is evicted: " + key(handle));
+        }
+        return *payloads_[owner];
     }
 
     const std::string& key(ResourceHandle<Resource> handle) const {
-        return handle_to_key_.at(handle.value);
+        check(handle);
+        return slots_[handle.value].key;
+    }
+
+    bool resident(ResourceHandle<Resource> handle) const {
+        check(handle);
+        return payloads_[payload(handle.value)].has_value();
+    }
+
+    uint32_t ref_count(ResourceHandle<Resource> handle) const {
+        check(handle);
+        return slots_[handle.value].ref_count;
+    }
+
+    void acquire(ResourceHandle<Resource> handle) {
+        check(handle);
+        slots_[handle.value].ref_count++;
+        uint32_t owner = payload(handle.value);
+        if (slots_[owner].pins++ == 0) {
+            unlink(owner);
+        }
+    }
+
+    void release(ResourceHandle<Resource> handle) {
+        check(handle);
+        auto& slot = slots_[handle.value];
+        if (slot.ref_count == 0) {
+            throw std::runtime_error("release of unreferenced resource: " + key(handle));
+        }
+        slot.ref_count--;
+        uint32_t owner = payload(handle.value);
+        if (--slots_[owner].pins == 0 && payloads_[owner]) {
+            link(owner);
+            trim(NO_SLOT);
+        }
+    }
+
+    void set_budget(size_t bytes) {
+        budget_ = bytes;
+        trim(NO_SLOT);
+    }
+
+    void trim() {
+        trim(NO_SLOT);
+    }
+
+    // An evicted owner is never a deduplication target: its payload cannot be compared, and a
+    // matching 64-bit hash alone would alias different content.
+    bool same_content(uint32_t raw_handle, const Resource& data) const {
+        return payloads_[raw_handle] && *payloads_[raw_handle] == data;
+    }
+
+    // Leaves raw_handle as the sole user of whatever payload it owns. An alias is split off its
+    // owner; an owner hands its payload, content index entry and remaining aliases to its first alias.
+    void detach(uint32_t raw_handle) {
+        auto& slot = slots_[raw_handle];
+        if (slot.owner != NO_SLOT) {
+            auto& owner = slots_[slot.owner];
+            std::erase(owner.aliases, raw_handle);
+            owner.pins -= slot.ref_count;
+            if (owner.pins == 0 && payloads_[slot.owner] && !owner.queued) {
+                link(slot.owner);
+            }
+            slot.owner = NO_SLOT;
+            slot.pins = slot.ref_count;
+            return;
+        }
+        if (slot.aliases.empty()) {
+            return;
+        }
+
+        uint32_t heir = slot.aliases.front();
+        auto& next = slots_[heir];
+        next.owner = NO_SLOT;
+        next.aliases.assign(slot.aliases.begin() + 1, slot.aliases.end());
+        for (uint32_t alias : next.aliases) {
+            slots_[alias].owner = heir;
+        }
+        next.pins = slot.pins - slot.ref_count;
+        slot.pins = slot.ref_count;
+        slot.aliases.clear();
+
+        if (payloads_[raw_handle]) {
+            unlink(raw_handle);
+            payloads_[heir] = std::move(payloads_[raw_handle]);
+            payloads_[raw_handle].reset();
+            next.bytes = std::exchange(slot.bytes, 0);
+            if (next.pins == 0) {
+                link(heir);
+            }
+        }
+        if (slot.hashed) {
+            uint64_t hash = slot.hash;
+            unindex_content(raw_handle);
+            index_content(heir, hash);
+        }
+    }
+
+    void index_content(uint32_t raw_handle, uint64_t hash) {
+        auto& slot = slots_[raw_handle];
+        slot.hash = hash;
+        slot.hashed = true;
+        hash_to_handle_.emplace(hash, raw_handle);
+    }
+
+    void unindex_content(uint32_t raw_handle) {
+        auto& slot = slots_[raw_handle];
+        if (!slot.hashed) {
+            return;
+        }
+        auto found = hash_to_handle_.find(slot.hash);
+        if (found != hash_to_handle_.end() && found->second == raw_handle) {
+            hash_to_handle_.erase(found);
+        }
+        slot.hashed = false;
+    }
+
+    void fill(uint32_t raw_handle, Resource data) {
+        payloads_[raw_handle].emplace(std::move(data));
+        auto& slot = slots_[raw_handle];
+        slot.bytes = resource_bytes(*payloads_[raw_handle]);
+        resident_bytes_ += slot.bytes;
+        if (slot.pins == 0) {
+            link(raw_handle);
+        }
+    }
+
+    void drop(uint32_t raw_handle) {
+        auto& slot = slots_[raw_handle];
+        unlink(raw_handle);
+        resident_bytes_ -= slot.bytes;
+        slot.bytes = 0;
+        payloads_[raw_handle].reset();
+    }
+
+    void reload(uint32_t raw_handle) {
+        const auto& resource_key = slots_[raw_handle].key;
+        if (!reloader_) {
+            throw std::runtime_error("resource is evicted and has no reloader: " + resource_key);
+        }
+        fill(raw_handle, reloader_(resource_key));
+    }
+
+    void trim(uint32_t keep) {
+        while (resident_bytes_ > budget_) {
+            uint32_t victim = lru_oldest_;
+            if (victim == keep && victim != NO_SLOT) {
+                victim = slots_[victim].newer;
+            }
+            if (victim == NO_SLOT) {
+                return;
+            }
+            drop(victim);
+            evictions_++;
+        }
+    }
+
+    void link(uint32_t raw_handle) {
+        auto& slot = slots_[raw_handle];
+        slot.older = lru_newest_;
+        slot.newer = NO_SLOT;
+        if (lru_newest_ != NO_SLOT) {
+            slots_[lru_newest_].newer = raw_handle;
+        } else {
+            lru_oldest_ = raw_handle;
+        }
+        lru_newest_ = raw_handle;
+        slot.queued = true;
+    }
+
+    void unlink(uint32_t raw_handle) {
+        auto& slot = slots_[raw_handle];
+        if (!slot.queued) {
+            return;
+        }
+        if (slot.older != NO_SLOT) {
+            slots_[slot.older].newer = slot.newer;
+        } else {
+            lru_oldest_ = slot.newer;
+        }
+        if (slot.newer != NO_SLOT) {
+            slots_[slot.newer].older = slot.older;
+        } else {
+            lru_newest_ = slot.older;
+        }
+        slot.queued = false;
+    }
+
+    void touch(uint32_t raw_handle) {
+        if (slots_[raw_handle].queued && lru_newest_ != raw_handle) {
+            unlink(raw_handle);
+            link(raw_handle);
+        }
     }
 };
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cask/container/string_map.hpp>
+#include <cask/resource/load_batch.hpp>
+#include <cask/resource/resource_handle.hpp>
+#include <cask/resource/resource_loader_registry.hpp>
+#include <cask/resource/resource_store.hpp>
+#include <cask/task/worker_pool.hpp>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+namespace cask {
+
+template<typename Resource>
+struct ResourceStreamer {
+    struct Loaded {
+        ResourceHandle<Resource> handle;
+        Resource data;
+    };
+
+    ResourceStore<Resource>& store_;
+    const ResourceLoaderRegistry<Resource>& loaders_;
+    Resource placeholder_;
+    std::unordered_set<std::string, StringHash, std::equal_to<>> failed_keys_;
+    LoadBatch<Loaded> batch_;
+
+    ResourceStreamer(ResourceStore<Resource>& store, const ResourceLoaderRegistry<Resource>& loaders, WorkerPool& pool, Resource placeholder)
+        : store_(store), loaders_(loaders), placeholder_(std::move(placeholder)), batch_(pool) {}
+
+    ResourceStreamer(const ResourceStreamer&) = delete;
+    ResourceStreamer& operator=(const ResourceStreamer&) = delete;
+
+    // A key whose load failed keeps its handle bound to the placeholder; requesting it again
+    // retries the load into that same handle.
+    ResourceHandle<Resource> request(std::string_view key, const nlohmann::json& loader_spec) {
+        auto existing = store_.find(key);
+        auto retry = failed_keys_.find(key);
+        if (existing && retry == failed_keys_.end()) {
+            return *existing;
+        }
+        const auto& loader = loaders_.get(loader_spec.at("loader").get_ref<const std::string&>());
+        if (existing) {
+            failed_keys_.erase(retry);
+        }
+        auto handle = existing ? *existing : store_.store_unique(key, placeholder_);
+
+        batch_.submit(std::string(key), [&loader, loader_spec, handle] {
+            return Loaded{handle, loader(loader_spec)};
+        });
+        return handle;
+    }
+
+    size_t pending() {
+        return batch_.pending();
+    }
+
+    size_t commit() {
+        auto [loaded, failed] = batch_.take();
+        for (auto& entry : loaded) {
+            if (store_.valid(entry.handle)) {
+                store_.replace(entry.handle, std::move(entry.data));
+            }
+        }
+        for (const auto& failure : failed) {
+            failed_keys_.insert(failure.key);
+        }
+        if (!failed.empty()) {
+            throw std::runtime_error(describe_load_failures("failed to stream resources", failed));
+        }
+        return loaded.size();
+    }
+
+    bool failed(std::string_view key) const {
+        return failed_keys_.contains(key);
+    }
+
+    void wait() {
+        batch_.wait();
+    }
+};
+
+}
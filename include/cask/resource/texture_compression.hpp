@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <cask/resource/payload_allocator.hpp>
+
+enum class BlockFormat : uint8_t {
+    bc1,
+    bc3
+};
+
+using RgbaBlock = std::array<uint8_t, 64>;
+
+inline size_t block_bytes(BlockFormat format) {
+    return format == BlockFormat::bc1 ? 8 : 16;
+}
+
+inline size_t compressed_size(BlockFormat format, uint32_t width, uint32_t height) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * block_bytes(format);
+}
+
+inline RgbaBlock read_block(std::span<const uint8_t> pixels, uint32_t width, uint32_t height, uint32_t channels, uint32_t block_x, uint32_t block_y) {
+    RgbaBlock block;
+    for (uint32_t row = 0; row < 4; ++row) {
+        uint32_t y = std::min(block_y * 4 + row, height - 1);
+        for (uint32_t column = 0; column < 4; ++column) {
+            uint32_t x = std::min(block_x * 4 + column, width - 1);
+            const uint8_t* pixel = pixels.data() + (static_cast<size_t>(y) * width + x) * channels;
+            uint8_t* target = block.data() + (row * 4 + column) * 4;
+            target[0] = pixel[0];
+            target[1] = channels >= 3 ? pixel[1] : pixel[0];
+            target[2] = channels >= 3 ? pixel[2] : pixel[0];
+            target[3] = channels == 4 ? pixel[3] : 255;
+        }
+    }
+    return block;
+}
+
+inline uint16_t pack_565(const float* color) {
+    auto quantize = [](float value, int bits) {
+        int levels = (1 << bits) - 1;
+        return static_cast<uint16_t>(std::clamp(static_cast<int>(std::lround(value / 255.0f * levels)), 0, levels));
+    };
+    return static_cast<uint16_t>((quantize(color[0], 5) << 11) | (quantize(color[1], 6) << 5) | quantize(color[2], 5));
+}
+
+inline std::array<uint8_t, 3> unpack_565(uint16_t packed) {
+    uint32_t red = (packed >> 11) & 0x1F;
+    uint32_t green = (packed >> 5) & 0x3F;
+    uint32_t blue = packed & 0x1F;
+    return {
+        static_cast<uint8_t>((red << 3) | (red >> 2)),
+        static_cast<uint8_t>((green << 2) | (green >> 4)),
+        static_cast<uint8_t>((blue << 3) | (blue >> 2))
+    };
+}
+
+inline std::array<std::array<uint8_t, 3>, 4> bc1_palette(uint16_t first, uint16_t second, bool four_color) {
+    auto color0 = unpack_565(first);
+    auto color1 = unpack_565(second);
+    std::array<std::array<uint8_t, 3>, 4> palette{color0, color1};
+    for (size_t channel = 0; channel < 3; ++channel) {
+        if (four_color) {
+            palette[2][channel] = static_cast<uint8_t>((2 * color0[channel] + color1[channel]) / 3);
+            palette[3][channel] = static_cast<uint8_t>((color0[channel] + 2 * color1[channel]) / 3);
+        } else {
+            palette[2][channel] = static_cast<uint8_t>((color0[channel] + color1[channel]) / 2);
+            palette[3][channel] = 0;
+        }
+    }
+    return palette;
+}
+
+inline void compress_bc1_block(const RgbaBlock& block, uint8_t* output) {
+    float mean[3] = {0, 0, 0};
+    for (size_t pixel = 0; pixel < 16; ++pixel) {
+        for (size_t channel = 0; channel < 3; ++channel) {
+            mean[channel] += block[pixel * 4 + channel] / 16.0f;
+        }
+    }
+
+    float covariance[6] = {0, 0, 0, 0, 0, 0};
+    for (size_t pixel = 0; pixel < 16; ++pixel) {
+        float r = block[pixel * 4] - mean[0];
+        float g = block[pixel * 4 + 1] - mean[1];
+        float b = block[pixel * 4 + 2] - mean[2];
+        covariance[0] += r * r;
+        covariance[1] += r * g;
+        covariance[2] += r * b;
+        covariance[3] += g * g;
+        covariance[4] += g * b;
+        covariance[5] += b * b;
+    }
+
+    float axis[3] = {1, 1, 1};
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[3] = {
+            covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+            covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+            covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+        };
+        float length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+        if (length == 0.0f) {
+            break;
+        }
+        for (size_t channel = 0; channel < 3; ++channel) {
+            axis[channel] = next[channel] / length;
+        }
+    }
+
+    float lowest = 0.0f;
+    float highest = 0.0f;
+    size_t low_pixel = 0;
+    size_t high_pixel = 0;
+    for (size_t pixel = 0; pixel < 16; ++pixel) {
+        float projection = 0.0f;
+        for (size_t channel = 0; channel < 3; ++channel) {
+            projection += (block[pixel * 4 + channel] - mean[channel]) * axis[channel];
+        }
+        if (pixel == 0 || projection < lowest) {
+            lowest = projection;
+            low_pixel = pixel;
+        }
+        if (pixel == 0 || projection > highest) {
+            highest = projection;
+            high_pixel = pixel;
+        }
+    }
+
+    float high_color[3];
+    float low_color[3];
+    for (size_t channel = 0; channel < 3; ++channel) {
+        high_color[channel] = block[high_pixel * 4 + channel];
+        low_color[channel] = block[low_pixel * 4 + channel];
+    }
+    uint16_t first = pack_565(high_color);
+    uint16_t second = pack_565(low_color);
+    if (first < second) {
+        std::swap(first, second);
+    }
+
+    uint32_t selectors = 0;
+    if (first != second) {
+        auto palette = bc1_palette(first, second, true);
+        for (size_t pixel = 0; pixel < 16; ++pixel) {
+            uint32_t best = 0;
+            int best_distance = -1;
+            for (uint32_t entry = 0; entry < 4; ++entry) {
+                int distance = 0;
+                for (size_t channel = 0; channel < 3; ++channel) {
+                    int delta = static_cast<int>(block[pixel * 4 + channel]) - palette[entry][channel];
+                    distance += delta * delta;
+                }
+                if (best_distance < 0 || distance < best_distance) {
+                    best_distance = distance;
+                    best = entry;
+                }
+            }
+            selectors |= best << (pixel * 2);
+        }
+    }
+
+    output[0] = static_cast<uint8_t>(first & 0xFF);
+    output[1] = static_cast<uint8_t>(first >> 8);
+    output[2] = static_cast<uint8_t>(second & 0xFF);
+    output[3] = static_cast<uint8_t>(second >> 8);
+    for (size_t byte = 0; byte < 4; ++byte) {
+        output[4 + byte] = static_cast<uint8_t>(selectors >> (byte * 8));
+    }
+}
+
+inline std::array<uint8_t, 8> bc3_alpha_palette(uint8_t first, uint8_t second) {
+    std::array<uint8_t, 8> palette{first, second};
+    if (first > second) {
+        for (uint32_t step = 1; step < 7; ++step) {
+            palette[step + 1] = static_cast<uint8_t>(((7 - step) * first + step * second) / 7);
+        }
+    } else {
+        for (uint32_t step = 1; step < 5; ++step) {
+            palette[step + 1] = static_cast<uint8_t>(((5 - step) * first + step * second) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    return palette;
+}
+
+inline void compress_bc3_block(const RgbaBlock& block, uint8_t* output) {
+    uint8_t highest = 0;
+    uint8_t lowest = 255;
+    for (size_t pixel = 0; pixel < 16; ++pixel) {
+        highest = std::max(highest, block[pixel * 4 + 3]);
+        lowest = std::min(lowest, block[pixel * 4 + 3]);
+    }
+
+    uint64_t selectors = 0;
+    if (highest != lowest) {
+        auto palette = bc3_alpha_palette(highest, lowest);
+        for (size_t pixel = 0; pixel < 16; ++pixel) {
+            uint64_t best = 0;
+            int best_distance = 256;
+            for (uint32_t entry = 0; entry < 8; ++entry) {
+                int distance = std::abs(static_cast<int>(block[pixel * 4 + 3]) - palette[entry]);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best = entry;
+                }
+            }
+            selectors |= best << (pixel * 3);
+        }
+    }
+
+    output[0] = highest;
+    output[1] = lowest;
+    for (size_t byte = 0; byte < 6; ++byte) {
+        output[2 + byte] = static_cast<uint8_t>(selectors >> (byte * 8));
+    }
+    compress_bc1_block(block, output + 8);
+}
+
+inline uint16_t read_565(const uint8_t* input) {
+    return static_cast<uint16_t>(input[0] | (input[1] << 8));
+}
+
+inline void decompress_color_block(const uint8_t* input, RgbaBlock& block, bool four_color) {
+    uint32_t selectors = input[4] | (input[5] << 8) | (input[6] << 16) | (static_cast<uint32_t>(input[7]) << 24);
+    auto palette = bc1_palette(read_565(input), read_565(input + 2), four_color);
+    for (size_t pixel = 0; pixel < 16; ++pixel) {
+        uint32_t entry = (selectors >> (pixel * 2)) & 0x3;
+        std::copy(palette[entry].begin(), palette[entry].end(), block.begin() + pixel * 4);
+        block[pixel * 4 + 3] = (!four_color && entry == 3) ? 0 : 255;
+    }
+}
+
+inline void decompress_bc1_block(const uint8_t* input, RgbaBlock& block) {
+    decompress_color_block(input, block, read_565(input) > read_565(input + 2));
+}
+
+// BC3 color blocks always interpolate four colors, whatever the endpoint order.
+inline void decompress_bc3_block(const uint8_t* input, RgbaBlock& block) {
+    decompress_color_block(input + 8, block, true);
+    auto palette = bc3_alpha_palette(input[0], input[1]);
+    uint64_t selectors = 0;
+    for (size_t byte = 0; byte < 6; ++byte) {
+        selectors |= static_cast<uint64_t>(input[2 + byte]) << (byte * 8);
+    }
+    for (size_t pixel = 0; pixel < 16; ++pixel) {
+        block[pixel * 4 + 3] = palette[(selectors >> (pixel * 3)) & 0x7];
+    }
+}
+
+inline cask::PayloadVector<uint8_t> compress_blocks(BlockFormat format, uint32_t width, uint32_t height, uint32_t channels, std::span<const uint8_t> pixels) {
+    cask::PayloadVector<uint8_t> compressed(compressed_size(format, width, height));
+    uint8_t* output = compressed.data();
+    for (uint32_t block_y = 0; block_y < (height + 3) / 4; ++block_y) {
+        for (uint32_t block_x = 0; block_x < (width + 3) / 4; ++block_x) {
+            auto block = read_block(pixels, width, height, channels, block_x, block_y);
+            if (format == BlockFormat::bc1) {
+                compress_bc1_block(block, output);
+            } else {
+                compress_bc3_block(block, output);
+            }
+            output += block_bytes(format);
+        }
+    }
+    return compressed;
+}
+
+inline std::vector<uint8_t> decompress_blocks(BlockFormat format, uint32_t width, uint32_t height, std::span<const uint8_t> compressed) {
+    if (compressed.size() != compressed_size(format, width, height)) {
+        throw std::runtime_error("compressed size does not match texture dimensions");
+    }
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    const uint8_t* input = compressed.data();
+    RgbaBlock block;
+    for (uint32_t block_y = 0; block_y < (height + 3) / 4; ++block_y) {
+        for (uint32_t block_x = 0; block_x < (width + 3) / 4; ++block_x) {
+            if (format == BlockFormat::bc1) {
+                decompress_bc1_block(input, block);
+            } else {
+                decompress_bc3_block(input, block);
+            }
+            input += block_bytes(format);
+            for (uint32_t row = 0; row < 4 && block_y * 4 + row < height; ++row) {
+                for (uint32_t column = 0; column < 4 && block_x * 4 + column < width; ++column) {
+                    size_t target = (static_cast<size_t>(block_y * 4 + row) * width + block_x * 4 + column) * 4;
+                    std::copy_n(block.begin() + (row * 4 + column) * 4, 4, pixels.begin() + target);
+                }
+            }
+        }
+    }
+    return pixels;
+}
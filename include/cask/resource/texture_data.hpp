@@ -1,19 +1,64 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include <cask/resource/content_hash.hpp>
+#include <cask/resource/payload_allocator.hpp>
+#include <cask/resource/resource_blob.hpp>
 #include <cask/resource/resource_handle.hpp>
+#include <cask/resource/texture_compression.hpp>
 
 using TextureHandle = ResourceHandle<struct TextureData>;
 
+struct TextureLevel {
+    uint32_t width;
+    uint32_t height;
+    cask::PayloadVector<uint8_t> data;
+
+    bool operator==(const TextureLevel&) const = default;
+};
+
 struct TextureData {
 private:
     uint32_t width_;
     uint32_t height_;
     uint32_t channels_;
-    std::vector<uint8_t> pixels_;
+    cask::PayloadVector<uint8_t> pixels_;
+    std::vector<TextureLevel> mips_;
+    std::optional<BlockFormat> compressed_format_;
+    std::vector<TextureLevel> compressed_;
+
+    TextureData() = default;
+
+    static void write_levels(cask::BlobWriter& writer, const std::vector<TextureLevel>& levels) {
+        writer.value<uint64_t>(levels.size());
+        for (const auto& level : levels) {
+            writer.value(level.width);
+            writer.value(level.height);
+            writer.array(level.data);
+        }
+    }
+
+    static void read_levels(cask::BlobReader& reader, std::vector<TextureLevel>& levels) {
+        uint64_t count = reader.value<uint64_t>();
+        for (uint64_t index = 0; index < count; ++index) {
+            TextureLevel level{};
+            level.width = reader.value<uint32_t>();
+            level.height = reader.value<uint32_t>();
+            reader.array(level.data);
+            levels.push_back(std::move(level));
+        }
+    }
 
     static void validate_width(uint32_t width) {
         if (width == 0) {
@@ -33,23 +78,256 @@ private:
         }
     }
 
-    static void validate_pixels(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, uint32_t channels) {
-        if (pixels.size() != width * height * channels) {
+    static void validate_pixels(std::span<const uint8_t> pixels, uint32_t width, uint32_t height, uint32_t channels) {
+        if (pixels.size() != static_cast<size_t>(width) * height * channels) {
             throw std::runtime_error("pixels size must equal width * height * channels");
         }
     }
 
-public:
-    TextureData(uint32_t width, uint32_t height, uint32_t channels, std::vector<uint8_t> pixels)
-        : width_(width), height_(height), channels_(channels), pixels_(std::move(pixels)) {
+    void validate(std::span<const uint8_t> pixels) const {
+        validate_width(width_);
+        validate_height(height_);
+        validate_channels(channels_);
+        validate_pixels(pixels, width_, height_, channels_);
+    }
+
+    static size_t mip_chain_length(uint32_t width, uint32_t height) {
+        return static_cast<size_t>(std::bit_width(std::max(width, height)));
+    }
+
+    void validate_level(const TextureLevel& level, size_t index, size_t bytes) const {
+        if (level.width != mip_width(index) || level.height != mip_height(index)) {
+            throw std::runtime_error("texture level size does not match its mip level");
+        }
+        if (level.data.size() != bytes) {
+            throw std::runtime_error("texture level data size does not match its dimensions");
+        }
+    }
+
+    void validate_storage() const {
         validate_width(width_);
         validate_height(height_);
         validate_channels(channels_);
-        validate_pixels(pixels_, width_, height_, channels_);
+        size_t chain = mip_chain_length(width_, height_);
+        if (has_pixels()) {
+            validate_pixels(pixels_, width_, height_, channels_);
+        } else if (!is_compressed() || !mips_.empty()) {
+            throw std::runtime_error("texture without pixels must hold only compressed levels");
+        }
+        if (!mips_.empty() && mips_.size() + 1 != chain) {
+            throw std::runtime_error("texture mip chain is incomplete");
+        }
+        for (size_t index = 0; index < mips_.size(); ++index) {
+            validate_level(mips_[index], index + 1, static_cast<size_t>(mip_width(index + 1)) * mip_height(index + 1) * channels_);
+        }
+        if (!is_compressed()) {
+            if (!compressed_.empty()) {
+                throw std::runtime_error("texture has compressed levels without a block format");
+            }
+            return;
+        }
+        if (*compressed_format_ > BlockFormat::bc3) {
+            throw std::runtime_error("texture block format is unknown");
+        }
+        if (compressed_.empty() || compressed_.size() > chain || (has_pixels() && compressed_.size() != mips_.size() + 1)) {
+            throw std::runtime_error("texture compressed levels do not match its mip chain");
+        }
+        for (size_t index = 0; index < compressed_.size(); ++index) {
+            validate_level(compressed_[index], index, compressed_size(*compressed_format_, mip_width(index), mip_height(index)));
+        }
+    }
+
+    struct DownsampleTap {
+        uint32_t first;
+        uint32_t count;
+        float weights[3];
+    };
+
+    // Odd sizes use the three-tap polyphase box, so the last row and column keep their weight.
+    static std::vector<DownsampleTap> downsample_taps(uint32_t source, uint32_t target) {
+        std::vector<DownsampleTap> taps(target);
+        for (uint32_t index = 0; index < target; ++index) {
+            if (source == 1) {
+                taps[index] = DownsampleTap{0, 1, {1.0f, 0.0f, 0.0f}};
+            } else if (source % 2 == 0) {
+                taps[index] = DownsampleTap{index * 2, 2, {0.5f, 0.5f, 0.0f}};
+            } else {
+                float scale = 1.0f / static_cast<float>(source);
+                taps[index] = DownsampleTap{index * 2, 3, {
+                    static_cast<float>(target - index) * scale,
+                    static_cast<float>(target) * scale,
+                    static_cast<float>(index + 1) * scale
+                }};
+            }
+        }
+        return taps;
+    }
+
+    static TextureLevel box_downsample(std::span<const uint8_t> source, uint32_t source_width, uint32_t source_height, uint32_t channels) {
+        uint32_t width = std::max(source_width / 2, 1u);
+        uint32_t height = std::max(source_height / 2, 1u);
+        auto columns = downsample_taps(source_width, width);
+        auto rows = downsample_taps(source_height, height);
+        TextureLevel level{width, height, cask::PayloadVector<uint8_t>(static_cast<size_t>(width) * height * channels)};
+        float sums[4];
+        for (uint32_t y = 0; y < height; ++y) {
+            const auto& row = rows[y];
+            uint8_t* target = level.data.data() + static_cast<size_t>(y) * width * channels;
+            for (uint32_t x = 0; x < width; ++x) {
+                const auto& column = columns[x];
+                std::fill_n(sums, channels, 0.0f);
+                for (uint32_t row_tap = 0; row_tap < row.count; ++row_tap) {
+                    const uint8_t* line = source.data() + static_cast<size_t>(row.first + row_tap) * source_width * channels;
+                    for (uint32_t column_tap = 0; column_tap < column.count; ++column_tap) {
+                        float weight = row.weights[row_tap] * column.weights[column_tap];
+                        const uint8_t* texel = line + static_cast<size_t>(column.first + column_tap) * channels;
+                        for (uint32_t channel = 0; channel < channels; ++channel) {
+                            sums[channel] += weight * texel[channel];
+                        }
+                    }
+                }
+                for (uint32_t channel = 0; channel < channels; ++channel) {
+                    target[x * channels + channel] = static_cast<uint8_t>(std::min(sums[channel] + 0.5f, 255.0f));
+                }
+            }
+        }
+        return level;
+    }
+
+public:
+    TextureData(uint32_t width, uint32_t height, uint32_t channels, cask::PayloadVector<uint8_t> pixels)
+        : width_(width), height_(height), channels_(channels) {
+        validate(pixels);
+        pixels_ = std::move(pixels);
+    }
+
+    template<typename Pixels>
+        requires std::ranges::contiguous_range<Pixels> && std::same_as<std::ranges::range_value_t<Pixels>, uint8_t>
+    TextureData(uint32_t width, uint32_t height, uint32_t channels, const Pixels& pixels)
+        : width_(width), height_(height), channels_(channels) {
+        validate(pixels);
+        pixels_.assign(std::ranges::begin(pixels), std::ranges::end(pixels));
     }
 
     uint32_t width() const { return width_; }
     uint32_t height() const { return height_; }
     uint32_t channels() const { return channels_; }
-    const std::vector<uint8_t>& pixels() const { return pixels_; }
+    std::span<const uint8_t> pixels() const { return pixels_; }
+    bool has_pixels() const { return !pixels_.empty(); }
+
+    size_t mip_count() const { return std::max(mips_.size() + 1, compressed_.size()); }
+
+    uint32_t mip_width(size_t level) const { return std::max(width_ >> level, 1u); }
+    uint32_t mip_height(size_t level) const { return std::max(height_ >> level, 1u); }
+
+    std::span<const uint8_t> mip_pixels(size_t level) const {
+        if (!has_pixels()) {
+            throw std::runtime_error("texture pixels were dropped after compression");
+        }
+        if (level == 0) {
+            return pixels_;
+        }
+        return mips_.at(level - 1).data;
+    }
+
+    void generate_mips() {
+        if (!has_pixels()) {
+            throw std::runtime_error("texture pixels were dropped after compression");
+        }
+        mips_.clear();
+        std::span<const uint8_t> source = pixels_;
+        uint32_t width = width_;
+        uint32_t height = height_;
+        while (width > 1 || height > 1) {
+            mips_.push_back(box_downsample(source, width, height, channels_));
+            source = mips_.back().data;
+            width = mips_.back().width;
+            height = mips_.back().height;
+        }
+        if (compressed_format_) {
+            compress(*compressed_format_);
+        }
+    }
+
+    bool is_compressed() const { return compressed_format_.has_value(); }
+    std::optional<BlockFormat> compressed_format() const { return compressed_format_; }
+    std::span<const uint8_t> compressed_level(size_t level) const { return compressed_.at(level).data; }
+
+    void compress(BlockFormat format) {
+        if (!has_pixels()) {
+            throw std::runtime_error("texture pixels were dropped after compression");
+        }
+        compressed_.clear();
+        for (size_t level = 0; level < mips_.size() + 1; ++level) {
+            uint32_t width = mip_width(level);
+            uint32_t height = mip_height(level);
+            compressed_.push_back(TextureLevel{width, height, compress_blocks(format, width, height, channels_, mip_pixels(level))});
+        }
+        compressed_format_ = format;
+    }
+
+    void drop_pixels() {
+        if (!is_compressed()) {
+            throw std::runtime_error("texture must be compressed before its pixels are dropped");
+        }
+        cask::PayloadVector<uint8_t>().swap(pixels_);
+        std::vector<TextureLevel>().swap(mips_);
+    }
+
+    size_t byte_size() const {
+        size_t bytes = pixels_.size();
+        for (const auto& level : mips_) {
+            bytes += level.data.size();
+        }
+        for (const auto& level : compressed_) {
+            bytes += level.data.size();
+        }
+        return bytes;
+    }
+
+    void write_blob(cask::BlobWriter& writer) const {
+        writer.value(width_);
+        writer.value(height_);
+        writer.value(channels_);
+        writer.array(pixels_);
+        write_levels(writer, mips_);
+        writer.value<uint8_t>(compressed_format_.has_value());
+        writer.value(compressed_format_.value_or(BlockFormat::bc1));
+        write_levels(writer, compressed_);
+    }
+
+    static TextureData read_blob(cask::BlobReader& reader) {
+        TextureData texture;
+        texture.width_ = reader.value<uint32_t>();
+        texture.height_ = reader.value<uint32_t>();
+        texture.channels_ = reader.value<uint32_t>();
+        reader.array(texture.pixels_);
+        read_levels(reader, texture.mips_);
+        bool compressed = reader.value<uint8_t>() != 0;
+        auto format = reader.value<BlockFormat>();
+        if (compressed) {
+            texture.compressed_format_ = format;
+        }
+        read_levels(reader, texture.compressed_);
+        texture.validate_storage();
+        return texture;
+    }
+
+    uint64_t content_hash() const {
+        uint32_t header[] = {width_, height_, channels_};
+        uint64_t hash = cask::hash_vector(pixels_, cask::hash_bytes(header, sizeof(header)));
+        for (const auto& level : mips_) {
+            hash = cask::hash_vector(level.data, hash);
+        }
+        for (const auto& level : compressed_) {
+            hash = cask::hash_vector(level.data, hash);
+        }
+        return hash;
+    }
+
+    bool operator==(const TextureData&) const = default;
 };
+
+inline TextureData placeholder_texture() {
+    return TextureData(1, 1, 4, {255, 0, 255, 255});
+}
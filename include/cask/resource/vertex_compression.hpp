@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+enum class IndexFormat : uint8_t {
+    uint16,
+    uint32
+};
+
+enum class NormalFormat : uint8_t {
+    float3,
+    octahedral
+};
+
+enum class UvFormat : uint8_t {
+    float2,
+    half2
+};
+
+// Half precision resolves [0, 1] to within a texel of a 4096 texture.
+inline constexpr float DEFAULT_HALF_UV_TOLERANCE = 1.0f / 4096.0f;
+
+struct MeshFormat {
+    IndexFormat indices = IndexFormat::uint32;
+    NormalFormat normals = NormalFormat::float3;
+    UvFormat uvs = UvFormat::float2;
+    float uv_tolerance = DEFAULT_HALF_UV_TOLERANCE;
+
+    bool operator==(const MeshFormat&) const = default;
+};
+
+inline IndexFormat select_index_format(std::span<const uint32_t> indices) {
+    uint32_t largest = indices.empty() ? 0 : *std::max_element(indices.begin(), indices.end());
+    return largest <= std::numeric_limits<uint16_t>::max() ? IndexFormat::uint16 : IndexFormat::uint32;
+}
+
+inline IndexFormat select_index_format(const std::vector<uint32_t>& indices) {
+    return select_index_format(std::span<const uint32_t>(indices));
+}
+
+inline uint16_t float_to_half(float value) {
+    uint32_t bits = std::bit_cast<uint32_t>(value);
+    auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    if (magnitude >= 0x7F800000) {
+        return sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x0200 : 0);
+    }
+    if (magnitude >= 0x477FF000) {
+        return sign | 0x7C00;
+    }
+    if (magnitude < 0x38800000) {
+        float subnormal = std::bit_cast<float>(magnitude) * 16777216.0f;
+        return sign | static_cast<uint16_t>(std::nearbyint(subnormal));
+    }
+    uint32_t rounded = magnitude + 0x0FFF + ((magnitude >> 13) & 1);
+    return sign | static_cast<uint16_t>((rounded - 0x38000000) >> 13);
+}
+
+inline float half_to_float(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x03FF;
+
+    if (exponent == 0) {
+        float subnormal = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -subnormal : subnormal;
+    }
+    if (exponent == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+inline bool halves_within(std::span<const float> values, float tolerance) {
+    return std::all_of(values.begin(), values.end(), [tolerance](float value) {
+        return std::abs(half_to_float(float_to_half(value)) - value) <= tolerance;
+    });
+}
+
+inline MeshFormat select_mesh_format(const std::vector<float>& uvs, float uv_tolerance = DEFAULT_HALF_UV_TOLERANCE) {
+    MeshFormat format;
+    format.normals = NormalFormat::octahedral;
+    format.uv_tolerance = uv_tolerance;
+    format.uvs = halves_within(uvs, uv_tolerance) ? UvFormat::half2 : UvFormat::float2;
+    return format;
+}
+
+inline int16_t snorm16(float value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+inline float sign_not_zero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+inline std::array<int16_t, 2> encode_octahedral(float x, float y, float z) {
+    float length = std::abs(x) + std::abs(y) + std::abs(z);
+    if (length == 0.0f) {
+        return {0, 0};
+    }
+    float u = x / length;
+    float v = y / length;
+    if (z < 0.0f) {
+        float folded_u = (1.0f - std::abs(v)) * sign_not_zero(u);
+        float folded_v = (1.0f - std::abs(u)) * sign_not_zero(v);
+        u = folded_u;
+        v = folded_v;
+    }
+    return {snorm16(u), snorm16(v)};
+}
+
+inline std::array<float, 3> decode_octahedral(int16_t encoded_u, int16_t encoded_v) {
+    float x = std::max(encoded_u / 32767.0f, -1.0f);
+    float y = std::max(encoded_v / 32767.0f, -1.0f);
+    float z = 1.0f - std::abs(x) - std::abs(y);
+    float fold = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -fold : fold;
+    y += y >= 0.0f ? -fold : fold;
+    float length = std::sqrt(x * x + y * y + z * z);
+    return {x / length, y / length, z / length};
+}
+
+inline void encode_normals(std::span<const float> normals, std::span<int16_t> encoded) {
+    for (size_t vertex = 0; vertex < normals.size() / 3; ++vertex) {
+        auto octahedral = encode_octahedral(normals[vertex * 3], normals[vertex * 3 + 1], normals[vertex * 3 + 2]);
+        encoded[vertex * 2] = octahedral[0];
+        encoded[vertex * 2 + 1] = octahedral[1];
+    }
+}
+
+inline std::vector<int16_t> encode_normals(const std::vector<float>& normals) {
+    std::vector<int16_t> encoded(normals.size() / 3 * 2);
+    encode_normals(normals, encoded);
+    return encoded;
+}
+
+inline std::vector<float> decode_normals(std::span<const int16_t> encoded) {
+    std::vector<float> normals(encoded.size() / 2 * 3);
+    for (size_t vertex = 0; vertex < encoded.size() / 2; ++vertex) {
+        auto normal = decode_octahedral(encoded[vertex * 2], encoded[vertex * 2 + 1]);
+        std::copy(normal.begin(), normal.end(), normals.begin() + vertex * 3);
+    }
+    return normals;
+}
+
+inline void encode_halves(std::span<const float> values, std::span<uint16_t> encoded) {
+    std::transform(values.begin(), values.end(), encoded.begin(), float_to_half);
+}
+
+inline std::vector<uint16_t> encode_halves(const std::vector<float>& values) {
+    std::vector<uint16_t> encoded(values.size());
+    encode_halves(values, encoded);
+    return encoded;
+}
+
+inline std::vector<float> decode_halves(std::span<const uint16_t> encoded) {
+    std::vector<float> values(encoded.size());
+    std::transform(encoded.begin(), encoded.end(), values.begin(), half_to_float);
+    return values;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+enum class VertexAttribute : uint8_t {
+    position,
+    normal,
+    uv
+};
+
+inline uint32_t attribute_components(VertexAttribute attribute) {
+    return attribute == VertexAttribute::uv ? 2 : 3;
+}
+
+inline uint32_t attribute_bytes(VertexAttribute attribute) {
+    return attribute_components(attribute) * sizeof(float);
+}
+
+struct VertexElement {
+    VertexAttribute attribute;
+    uint32_t offset;
+
+    bool operator==(const VertexElement&) const = default;
+};
+
+struct VertexLayout {
+    std::vector<VertexElement> elements;
+    uint32_t stride = 0;
+
+    bool operator==(const VertexLayout&) const = default;
+};
+
+inline VertexLayout make_vertex_layout(std::initializer_list<VertexAttribute> attributes, uint32_t stride = 0) {
+    if (attributes.size() == 0) {
+        throw std::runtime_error("vertex layout must have at least one attribute");
+    }
+    VertexLayout layout;
+    uint32_t offset = 0;
+    for (auto attribute : attributes) {
+        layout.elements.push_back(VertexElement{attribute, offset});
+        offset += attribute_bytes(attribute);
+    }
+    if (stride != 0 && stride < offset) {
+        throw std::runtime_error("vertex stride is smaller than its attributes");
+    }
+    if (stride % sizeof(float) != 0) {
+        throw std::runtime_error("vertex stride must be a multiple of 4 bytes");
+    }
+    layout.stride = stride == 0 ? offset : stride;
+    return layout;
+}
+
+// Layouts built by hand or read back from a blob skip make_vertex_layout, so interleave checks
+// every element fits inside the stride and no two elements share bytes before writing.
+inline void validate_vertex_layout(const VertexLayout& layout) {
+    if (layout.elements.empty()) {
+        throw std::runtime_error("vertex layout must have at least one attribute");
+    }
+    std::vector<VertexElement> sorted = layout.elements;
+    std::sort(sorted.begin(), sorted.end(), [](const VertexElement& left, const VertexElement& right) {
+        return left.offset < right.offset;
+    });
+    uint64_t end = 0;
+    for (const auto& element : sorted) {
+        if (element.attribute > VertexAttribute::uv) {
+            throw std::runtime_error("vertex layout has an unknown attribute");
+        }
+        if (element.offset < end) {
+            throw std::runtime_error("vertex layout elements overlap");
+        }
+        end = uint64_t{element.offset} + attribute_bytes(element.attribute);
+        if (end > layout.stride) {
+            throw std::runtime_error("vertex element extends past the stride");
+        }
+    }
+}
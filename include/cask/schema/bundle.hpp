@@ -20,7 +20,7 @@ inline nlohmann::json save_bundle(
     return bundle;
 }
 
-inline nlohmann::json load_bundle(
+inline LoadContext load_bundle(
     const nlohmann::json& bundle_data,
     const SerializationRegistry& registry,
     PluginLoader plugin_loader,
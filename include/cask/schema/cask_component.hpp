@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cask/schema/describe.hpp>
+#include <tuple>
 
 #define CASK_PAIR_TYPE(type, name) type
 #define CASK_PAIR_NAME(type, name) name
@@ -9,7 +10,7 @@
 #define CASK_FIELD_DECL(pair) CASK_PAIR_TYPE pair CASK_PAIR_NAME pair;
 
 #define CASK_FIELD_DESC(StructName, pair) \
-    cask::field(CASK_PAIR_NAME_STR pair, &StructName::CASK_PAIR_NAME pair)
+    cask::static_field(CASK_PAIR_NAME_STR pair, &StructName::CASK_PAIR_NAME pair)
 
 #define CASK_CONCAT(a, b) CASK_CONCAT_IMPL(a, b)
 #define CASK_CONCAT_IMPL(a, b) a ## b
@@ -56,9 +57,10 @@
 #define CASK_COMPONENT(StructName, ...) \
     struct StructName { \
         CASK_FOR_EACH(CASK_FIELD_DECL, __VA_ARGS__) \
+        static constexpr auto fields() { \
+            return std::make_tuple(CASK_DESC(StructName, __VA_ARGS__)); \
+        } \
         static cask::RegistryEntry describe() { \
-            return cask::describe<StructName>(#StructName, { \
-                CASK_DESC(StructName, __VA_ARGS__) \
-            }); \
+            return cask::describe_static<StructName>(#StructName); \
         } \
     };
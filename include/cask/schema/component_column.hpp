@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cask/ecs/component_store.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+namespace cask {
+
+inline constexpr uint32_t COLUMN_MAGIC = 0x4c4f4343;
+inline constexpr uint32_t COLUMN_VERSION = 1;
+inline constexpr size_t COLUMN_ALIGNMENT = 64;
+
+struct ColumnHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t stride;
+    uint32_t alignment;
+    uint64_t count;
+    uint64_t entities_offset;
+    uint64_t values_offset;
+};
+
+inline size_t align_column_offset(size_t offset) {
+    return (offset + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+}
+
+template<typename T>
+std::vector<std::byte> write_column(const ComponentStore<T>& store) {
+    static_assert(std::is_trivially_copyable_v<T>, "column images require trivially copyable components");
+
+    size_t count = store.dense_.size();
+    size_t entities_offset = align_column_offset(sizeof(ColumnHeader));
+    size_t values_offset = align_column_offset(entities_offset + count * sizeof(uint32_t));
+
+    ColumnHeader header{
+        COLUMN_MAGIC,
+        COLUMN_VERSION,
+        static_cast<uint32_t>(sizeof(T)),
+        static_cast<uint32_t>(alignof(T)),
+        count,
+        entities_offset,
+        values_offset
+    };
+
+    std::vector<std::byte> image(values_offset + count * sizeof(T));
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(image.data() + entities_offset, store.index_to_entity_.data(), count * sizeof(uint32_t));
+    std::memcpy(image.data() + values_offset, store.dense_.data(), count * sizeof(T));
+    return image;
+}
+
+inline bool column_fits(std::span<const std::byte> image, uint64_t offset, uint64_t count, size_t element_size) {
+    return offset >= sizeof(ColumnHeader) &&
+        offset <= image.size() &&
+        count <= (image.size() - offset) / element_size;
+}
+
+template<typename T>
+ColumnHeader read_column_header(std::span<const std::byte> image) {
+    if (image.size() < sizeof(ColumnHeader)) {
+        throw std::runtime_error("column image is smaller than its header");
+    }
+    ColumnHeader header{};
+    std::memcpy(&header, image.data(), sizeof(header));
+    if (header.magic != COLUMN_MAGIC) {
+        throw std::runtime_error("column image has invalid magic");
+    }
+    if (header.version != COLUMN_VERSION) {
+        throw std::runtime_error("column image has unsupported version");
+    }
+    if (header.stride != sizeof(T)) {
+        throw std::runtime_error("column image stride does not match component size");
+    }
+    if (header.alignment != alignof(T) ||
+        header.entities_offset % alignof(uint32_t) != 0 ||
+        header.values_offset % alignof(T) != 0) {
+        throw std::runtime_error("column image alignment does not match component");
+    }
+    if (!column_fits(image, header.entities_offset, header.count, sizeof(uint32_t)) ||
+        !column_fits(image, header.values_offset, header.count, sizeof(T))) {
+        throw std::runtime_error("column image is truncated");
+    }
+    return header;
+}
+
+template<typename T, typename Remap>
+void read_column(std::span<const std::byte> image, ComponentStore<T>& store, Remap remap) {
+    static_assert(std::is_trivially_copyable_v<T>, "column images require trivially copyable components");
+
+    ColumnHeader header = read_column_header<T>(image);
+    size_t count = static_cast<size_t>(header.count);
+    size_t base = store.dense_.size();
+
+    std::vector<uint32_t> entities(count);
+    std::memcpy(entities.data(), image.data() + header.entities_offset, count * sizeof(uint32_t));
+    std::unordered_set<uint32_t> seen;
+    seen.reserve(count);
+    for (auto& entity : entities) {
+        entity = remap(entity);
+        if (store.has(entity)) {
+            throw std::runtime_error("column image entity is already in the store");
+        }
+        if (!seen.insert(entity).second) {
+            throw std::runtime_error("column image repeats an entity");
+        }
+    }
+
+    store.dense_.resize(base + count);
+    std::memcpy(store.dense_.data() + base, image.data() + header.values_offset, count * sizeof(T));
+    store.index_to_entity_.insert(store.index_to_entity_.end(), entities.begin(), entities.end());
+
+    store.entity_to_index_.reserve(base + count);
+    for (size_t index = 0; index < count; ++index) {
+        store.entity_to_index_.emplace(entities[index], base + index);
+        store.record(entities[index], ComponentChange::inserted);
+    }
+}
+
+template<typename T>
+void read_column(std::span<const std::byte> image, ComponentStore<T>& store) {
+    read_column(image, store, [](uint32_t entity) { return entity; });
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cask/schema/bundle.hpp>
+#include <cask/schema/compressed_stream.hpp>
+#include <istream>
+#include <nlohmann/json.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cask {
+
+enum class BundleCompression {
+    none,
+    zstd
+};
+
+inline void write_bundle(
+    std::ostream& output,
+    const nlohmann::json& bundle,
+    BundleCompression compression = BundleCompression::none,
+    int level = ZSTD_CLEVEL_DEFAULT
+) {
+    if (compression == BundleCompression::none) {
+        output << bundle;
+        return;
+    }
+    ZstdOutputBuffer buffer(output, level);
+    std::ostream compressed(&buffer);
+    compressed << bundle;
+    buffer.finish();
+}
+
+inline nlohmann::json read_bundle(std::istream& input) {
+    SniffedInputBuffer sniffed(input, ZSTD_MAGIC_BYTES);
+    std::istream source(&sniffed);
+    if (!is_zstd_frame(sniffed.sniffed())) {
+        return nlohmann::json::parse(source);
+    }
+    ZstdInputBuffer buffer(source);
+    std::istream decompressed(&buffer);
+    try {
+        return nlohmann::json::parse(decompressed);
+    } catch (...) {
+        buffer.rethrow();
+        throw;
+    }
+}
+
+inline void save_bundle(
+    std::ostream& output,
+    const std::vector<std::string>& plugin_names,
+    const std::vector<std::string>& component_names,
+    const SerializationRegistry& registry,
+    ComponentResolver component_resolver,
+    BundleCompression compression = BundleCompression::none
+) {
+    write_bundle(output, save_bundle(plugin_names, component_names, registry, component_resolver), compression);
+}
+
+inline LoadContext load_bundle(
+    std::istream& input,
+    const SerializationRegistry& registry,
+    PluginLoader plugin_loader,
+    ComponentResolver component_resolver
+) {
+    return load_bundle(read_bundle(input), registry, plugin_loader, component_resolver);
+}
+
+}
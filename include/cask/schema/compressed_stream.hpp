@@ -0,0 +1,286 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <zstd.h>
+
+namespace cask {
+
+inline constexpr size_t COMPRESSED_CHUNK_BYTES = 256 * 1024;
+inline constexpr size_t COMPRESSED_QUEUE_DEPTH = 4;
+inline constexpr uint32_t ZSTD_FRAME_MAGIC = 0xFD2FB528;
+
+inline void check_zstd(size_t result) {
+    if (ZSTD_isError(result)) {
+        throw std::runtime_error(std::string("zstd: ") + ZSTD_getErrorName(result));
+    }
+}
+
+struct ChunkQueue {
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<std::vector<char>> chunks_;
+    std::exception_ptr error_;
+    bool closed_ = false;
+
+    bool push(std::vector<char> chunk) {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock, [this] { return closed_ || chunks_.size() < COMPRESSED_QUEUE_DEPTH; });
+        if (closed_) {
+            return false;
+        }
+        chunks_.push_back(std::move(chunk));
+        changed_.notify_all();
+        return true;
+    }
+
+    std::optional<std::vector<char>> pop() {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock, [this] { return closed_ || !chunks_.empty(); });
+        if (chunks_.empty()) {
+            return std::nullopt;
+        }
+        auto chunk = std::move(chunks_.front());
+        chunks_.pop_front();
+        changed_.notify_all();
+        return chunk;
+    }
+
+    void close(std::exception_ptr error = nullptr) {
+        std::lock_guard lock(mutex_);
+        if (error && !error_) {
+            error_ = error;
+        }
+        closed_ = true;
+        changed_.notify_all();
+    }
+
+    void rethrow() {
+        std::lock_guard lock(mutex_);
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+};
+
+// Buffers written bytes into chunks that a background thread compresses into one zstd frame.
+struct ZstdOutputBuffer : std::streambuf {
+    std::ostream& sink_;
+    int level_;
+    ChunkQueue queue_;
+    std::vector<char> chunk_;
+    std::thread worker_;
+
+    explicit ZstdOutputBuffer(std::ostream& sink, int level = ZSTD_CLEVEL_DEFAULT)
+        : sink_(sink), level_(level), chunk_(COMPRESSED_CHUNK_BYTES) {
+        setp(chunk_.data(), chunk_.data() + chunk_.size());
+        worker_ = std::thread([this] { compress(); });
+    }
+
+    ZstdOutputBuffer(const ZstdOutputBuffer&) = delete;
+    ZstdOutputBuffer& operator=(const ZstdOutputBuffer&) = delete;
+
+    ~ZstdOutputBuffer() override {
+        if (worker_.joinable()) {
+            queue_.close();
+            worker_.join();
+        }
+    }
+
+    void finish() {
+        submit();
+        queue_.close();
+        worker_.join();
+        queue_.rethrow();
+        sink_.flush();
+    }
+
+    void submit() {
+        size_t used = static_cast<size_t>(pptr() - pbase());
+        if (used == 0) {
+            return;
+        }
+        chunk_.resize(used);
+        std::vector<char> next(COMPRESSED_CHUNK_BYTES);
+        if (!queue_.push(std::exchange(chunk_, std::move(next)))) {
+            queue_.rethrow();
+        }
+        setp(chunk_.data(), chunk_.data() + chunk_.size());
+    }
+
+    int_type overflow(int_type character) override {
+        submit();
+        if (!traits_type::eq_int_type(character, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(character);
+            pbump(1);
+        }
+        return traits_type::not_eof(character);
+    }
+
+    void compress() {
+        ZSTD_CCtx* context = ZSTD_createCCtx();
+        std::vector<char> output(ZSTD_CStreamOutSize());
+        try {
+            check_zstd(ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level_));
+            auto drain = [&](ZSTD_inBuffer& input, ZSTD_EndDirective directive) {
+                size_t remaining = 0;
+                do {
+                    ZSTD_outBuffer out{output.data(), output.size(), 0};
+                    remaining = ZSTD_compressStream2(context, &out, &input, directive);
+                    check_zstd(remaining);
+                    sink_.write(output.data(), static_cast<std::streamsize>(out.pos));
+                    if (!sink_) {
+                        throw std::runtime_error("failed to write compressed bundle");
+                    }
+                } while (directive == ZSTD_e_end ? remaining != 0 : input.pos < input.size);
+            };
+
+            while (auto chunk = queue_.pop()) {
+                ZSTD_inBuffer input{chunk->data(), chunk->size(), 0};
+                drain(input, ZSTD_e_continue);
+            }
+            ZSTD_inBuffer end{nullptr, 0, 0};
+            drain(end, ZSTD_e_end);
+        } catch (...) {
+            queue_.close(std::current_exception());
+        }
+        ZSTD_freeCCtx(context);
+    }
+};
+
+// Decompresses a zstd frame on a background thread so the reader can parse while it inflates.
+struct ZstdInputBuffer : std::streambuf {
+    std::istream& source_;
+    ChunkQueue queue_;
+    std::vector<char> chunk_;
+    std::thread worker_;
+
+    explicit ZstdInputBuffer(std::istream& source) : source_(source) {
+        setg(nullptr, nullptr, nullptr);
+        worker_ = std::thread([this] { decompress(); });
+    }
+
+    ZstdInputBuffer(const ZstdInputBuffer&) = delete;
+    ZstdInputBuffer& operator=(const ZstdInputBuffer&) = delete;
+
+    ~ZstdInputBuffer() override {
+        queue_.close();
+        worker_.join();
+    }
+
+    void rethrow() {
+        queue_.rethrow();
+    }
+
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        auto chunk = queue_.pop();
+        if (!chunk) {
+            queue_.rethrow();
+            return traits_type::eof();
+        }
+        chunk_ = std::move(*chunk);
+        setg(chunk_.data(), chunk_.data(), chunk_.data() + chunk_.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+    void decompress() {
+        ZSTD_DCtx* context = ZSTD_createDCtx();
+        std::vector<char> input(ZSTD_DStreamInSize());
+        try {
+            size_t pending = 0;
+            bool started = false;
+            while (source_) {
+                source_.read(input.data(), static_cast<std::streamsize>(input.size()));
+                size_t read = static_cast<size_t>(source_.gcount());
+                if (read == 0) {
+                    break;
+                }
+                started = true;
+                ZSTD_inBuffer in{input.data(), read, 0};
+                bool full = false;
+                do {
+                    std::vector<char> output(ZSTD_DStreamOutSize());
+                    ZSTD_outBuffer out{output.data(), output.size(), 0};
+                    pending = ZSTD_decompressStream(context, &out, &in);
+                    check_zstd(pending);
+                    full = out.pos == out.size;
+                    output.resize(out.pos);
+                    if (!output.empty() && !queue_.push(std::move(output))) {
+                        ZSTD_freeDCtx(context);
+                        return;
+                    }
+                } while (in.pos < in.size || full);
+            }
+            if (!started || pending != 0) {
+                throw std::runtime_error("compressed bundle is truncated");
+            }
+            queue_.close();
+        } catch (...) {
+            queue_.close(std::current_exception());
+        }
+        ZSTD_freeDCtx(context);
+    }
+};
+
+inline constexpr size_t ZSTD_MAGIC_BYTES = 4;
+
+inline bool is_zstd_frame(std::string_view bytes) {
+    if (bytes.size() < ZSTD_MAGIC_BYTES) {
+        return false;
+    }
+    auto byte = [bytes](size_t index) { return static_cast<uint32_t>(static_cast<unsigned char>(bytes[index])); };
+    return (byte(0) | byte(1) << 8 | byte(2) << 16 | byte(3) << 24) == ZSTD_FRAME_MAGIC;
+}
+
+// Reads the leading bytes straight from the source's streambuf and replays them ahead of
+// the rest, so the format can be sniffed on pipes and sockets that cannot seek back.
+struct SniffedInputBuffer : std::streambuf {
+    std::streambuf* source_;
+    std::vector<char> buffer_;
+    std::string sniffed_;
+
+    SniffedInputBuffer(std::istream& source, size_t count) : source_(source.rdbuf()), buffer_(COMPRESSED_CHUNK_BYTES) {
+        auto read = source_ ? source_->sgetn(buffer_.data(), static_cast<std::streamsize>(count)) : 0;
+        sniffed_.assign(buffer_.data(), static_cast<size_t>(read));
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + read);
+    }
+
+    SniffedInputBuffer(const SniffedInputBuffer&) = delete;
+    SniffedInputBuffer& operator=(const SniffedInputBuffer&) = delete;
+
+    std::string_view sniffed() const {
+        return sniffed_;
+    }
+
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        auto read = source_ ? source_->sgetn(buffer_.data(), static_cast<std::streamsize>(buffer_.size())) : 0;
+        if (read <= 0) {
+            return traits_type::eof();
+        }
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + read);
+        return traits_type::to_int_type(*gptr());
+    }
+};
+
+}
@@ -2,10 +2,15 @@
 
 #include <cask/schema/serialization_registry.hpp>
 #include <cask/schema/type_name.hpp>
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace cask {
@@ -85,24 +90,46 @@ inline nlohmann::json build_schema(const char* name, size_t struct_size, const s
     return {{"name", name}, {"size", struct_size}, {"fields", fields_json}};
 }
 
+inline std::vector<std::string> build_field_keys(const std::vector<FieldInfo>& fields) {
+    std::vector<std::string> keys;
+    keys.reserve(fields.size());
+    for (const auto& field_info : fields) {
+        keys.push_back(field_info.metadata["name"].get<std::string>());
+    }
+    return keys;
+}
+
+// Each call clones a prototype object whose keys are already in place, then fills the values in
+// key order. The clone copies the key tree without comparing or rebalancing, and field names
+// short enough for the small-string buffer are copied without allocating.
 inline SerializeFn build_serialize(const std::vector<FieldInfo>& fields) {
-    return [fields](const void* instance) -> nlohmann::json {
-        nlohmann::json result = nlohmann::json::object();
-        for (const auto& field_info : fields) {
-            std::string field_name = field_info.metadata["name"].get<std::string>();
-            result[field_name] = field_info.serialize(instance);
+    auto keys = build_field_keys(fields);
+    nlohmann::json prototype = nlohmann::json::object();
+    for (const auto& key : keys) {
+        prototype.emplace(key, nullptr);
+    }
+
+    std::vector<size_t> order;
+    order.reserve(prototype.size());
+    for (const auto& [key, _] : prototype.items()) {
+        order.push_back(static_cast<size_t>(std::find(keys.begin(), keys.end(), key) - keys.begin()));
+    }
+
+    return [fields, prototype = std::move(prototype), order = std::move(order)](const void* instance) -> nlohmann::json {
+        nlohmann::json result = prototype;
+        size_t slot = 0;
+        for (auto& value : result) {
+            value = fields[order[slot++]].serialize(instance);
         }
         return result;
     };
 }
 
 inline DeserializeFn build_deserialize(const std::vector<FieldInfo>& fields) {
-    return [fields](const nlohmann::json& json, void* instance, const nlohmann::json&) -> nlohmann::json {
-        for (const auto& field_info : fields) {
-            std::string field_name = field_info.metadata["name"].get<std::string>();
-            field_info.deserialize(json.at(field_name), instance);
+    return [fields, keys = build_field_keys(fields)](const nlohmann::json& json, void* instance, LoadContext&) {
+        for (size_t index = 0; index < fields.size(); ++index) {
+            fields[index].deserialize(json.at(keys[index]), instance);
         }
-        return nlohmann::json::object();
     };
 }
 
@@ -121,4 +148,96 @@ RegistryEntry describe(const char* name, std::initializer_list<FieldInfo> field_
     };
 }
 
+template<typename T, typename M>
+struct StaticField {
+    using member_type = M;
+
+    const char* name;
+    M T::* member;
+};
+
+template<typename T, typename M>
+constexpr StaticField<T, M> static_field(const char* name, M T::* member) {
+    return StaticField<T, M>{name, member};
+}
+
+template<typename Field>
+using static_field_type = typename std::decay_t<Field>::member_type;
+
+template<typename T>
+nlohmann::json build_static_schema(const char* name) {
+    nlohmann::json fields_json = nlohmann::json::array();
+    std::apply([&fields_json](const auto&... static_fields) {
+        (fields_json.push_back({
+            {"name", static_fields.name},
+            {"type", type_name<static_field_type<decltype(static_fields)>>::value},
+            {"size", sizeof(static_field_type<decltype(static_fields)>)}
+        }), ...);
+    }, T::fields());
+    return {{"name", name}, {"size", sizeof(T)}, {"fields", fields_json}};
+}
+
+template<typename T>
+inline constexpr size_t static_field_count = std::tuple_size_v<decltype(T::fields())>;
+
+template<typename T>
+struct StaticFieldPrototype {
+    nlohmann::json object;
+    std::array<size_t, static_field_count<T>> slots;
+};
+
+// The prototype object and each field's slot in its key order are built once per type, so
+// serialize_fields clones keys the way build_serialize does instead of emplacing them.
+template<typename T>
+const StaticFieldPrototype<T>& static_field_prototype() {
+    static const StaticFieldPrototype<T> prototype = [] {
+        StaticFieldPrototype<T> built{nlohmann::json::object(), {}};
+        std::apply([&built](const auto&... static_fields) {
+            (built.object.emplace(static_fields.name, nullptr), ...);
+            size_t index = 0;
+            ((built.slots[index++] = static_cast<size_t>(std::distance(built.object.begin(), built.object.find(static_fields.name)))), ...);
+        }, T::fields());
+        return built;
+    }();
+    return prototype;
+}
+
+template<typename T>
+nlohmann::json serialize_fields(const T& instance) {
+    const auto& prototype = static_field_prototype<T>();
+    nlohmann::json result = prototype.object;
+    std::array<nlohmann::json*, static_field_count<T>> values{};
+    size_t slot = 0;
+    for (auto& value : result) {
+        values[slot++] = &value;
+    }
+    std::apply([&values, &prototype, &instance](const auto&... static_fields) {
+        size_t index = 0;
+        ((*values[prototype.slots[index++]] = instance.*(static_fields.member)), ...);
+    }, T::fields());
+    return result;
+}
+
+template<typename T>
+void deserialize_fields(const nlohmann::json& json, T& instance) {
+    std::apply([&json, &instance](const auto&... static_fields) {
+        ((instance.*(static_fields.member) =
+            json.at(static_fields.name).template get<static_field_type<decltype(static_fields)>>()), ...);
+    }, T::fields());
+}
+
+template<typename T>
+RegistryEntry describe_static(const char* name) {
+    return RegistryEntry{
+        build_static_schema<T>(name),
+        [](const void* instance) -> nlohmann::json {
+            return serialize_fields(*static_cast<const T*>(instance));
+        },
+        [](const nlohmann::json& json, void* instance, LoadContext&) {
+            deserialize_fields(json, *static_cast<T*>(instance));
+        },
+        {}
+    };
+}
+
 }
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <cask/ecs/component_store.hpp>
+#include <cask/schema/describe.hpp>
 #include <cask/schema/serialization_registry.hpp>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
 namespace cask {
 
@@ -22,22 +27,96 @@ SerializeFn build_store_serialize(const RegistryEntry& value_entry) {
 
 template<typename T>
 DeserializeFn build_store_deserialize(const RegistryEntry& value_entry) {
-    return [value_entry](const nlohmann::json& json, void* instance, const nlohmann::json& context) -> nlohmann::json {
+    return [value_entry](const nlohmann::json& json, void* instance, LoadContext& context) {
         auto* store = static_cast<ComponentStore<T>*>(instance);
-        const auto& remap = context.at("entity_remap");
+        const auto& remap = context.entity_remap;
 
         for (const auto& [key, value_json] : json.items()) {
-            auto remap_found = remap.find(key);
-            if (remap_found == remap.end()) {
-                throw std::runtime_error("entity_remap missing key: " + key);
-            }
-            uint32_t entity = remap_found->get<uint32_t>();
+            uint32_t entity = remap.at(parse_entity_id(key));
             T value{};
-            value_entry.deserialize(value_json, &value, nlohmann::json{});
+            value_entry.deserialize(value_json, &value, context);
             store->insert(entity, std::move(value));
         }
+    };
+}
+
+template<typename T>
+void upsert_component(ComponentStore<T>& store, uint32_t entity, T value) {
+    if (store.has(entity)) {
+        store.modify(entity) = std::move(value);
+    } else {
+        store.insert(entity, std::move(value));
+    }
+}
 
-        return nlohmann::json::object();
+template<typename T>
+void require_store_baseline(const ComponentStore<T>& store) {
+    if (!store.tracking_) {
+        throw std::runtime_error("component store delta saved without a rebased baseline");
+    }
+}
+
+template<typename T>
+nlohmann::json write_store_removals(const ComponentStore<T>& store) {
+    nlohmann::json removed = nlohmann::json::array();
+    store.each_change([&removed](uint32_t entity, ComponentChange change) {
+        if (change == ComponentChange::removed) {
+            removed.push_back(entity);
+        }
+    });
+    return removed;
+}
+
+template<typename T>
+void apply_store_removals(const nlohmann::json& removed, ComponentStore<T>& store, const EntityRemap& remap) {
+    for (const auto& file_entity : removed) {
+        uint32_t local = file_entity.template get<uint32_t>();
+        if (!remap.has(local)) {
+            continue;
+        }
+        uint32_t entity = remap.at(local);
+        if (store.has(entity)) {
+            store.remove(entity);
+        }
+    }
+}
+
+template<typename T>
+RebaseFn build_store_rebase() {
+    return [](void* instance) {
+        static_cast<ComponentStore<T>*>(instance)->rebase();
+    };
+}
+
+template<typename T>
+SerializeFn build_store_delta_serialize(const RegistryEntry& value_entry) {
+    return [value_entry](const void* instance) -> nlohmann::json {
+        const auto* store = static_cast<const ComponentStore<T>*>(instance);
+        require_store_baseline(*store);
+        nlohmann::json upserted = nlohmann::json::object();
+
+        store->each_change([&upserted, &value_entry, store](uint32_t entity, ComponentChange change) {
+            if (change != ComponentChange::removed) {
+                upserted[std::to_string(entity)] = value_entry.serialize(&store->get(entity));
+            }
+        });
+
+        return {{"upsert", std::move(upserted)}, {"remove", write_store_removals(*store)}};
+    };
+}
+
+template<typename T>
+DeserializeFn build_store_delta_apply(const RegistryEntry& value_entry) {
+    return [value_entry](const nlohmann::json& json, void* instance, LoadContext& context) {
+        auto* store = static_cast<ComponentStore<T>*>(instance);
+        apply_store_removals(json.at("remove"), *store, context.entity_remap);
+
+        for (const auto& [key, value_json] : json.at("upsert").items()) {
+            uint32_t entity = context.entity_remap.at(parse_entity_id(key));
+            T value{};
+            value_entry.deserialize(value_json, &value, context);
+            upsert_component(*store, entity, std::move(value));
+        }
     };
 }
 
@@ -55,7 +134,131 @@ RegistryEntry describe_component_store(const char* name, const RegistryEntry& va
         std::move(schema),
         build_store_serialize<T>(value_entry),
         build_store_deserialize<T>(value_entry),
-        {"EntityRegistry"}
+        {"EntityRegistry"},
+        {build_store_delta_serialize<T>(value_entry), build_store_delta_apply<T>(value_entry), build_store_rebase<T>()}
+    };
+}
+
+template<typename T, typename Field>
+nlohmann::json write_field_column(const std::vector<T>& values, const Field& static_field) {
+    nlohmann::json::array_t column;
+    column.reserve(values.size());
+    for (const auto& value : values) {
+        column.emplace_back(value.*(static_field.member));
+    }
+    return column;
+}
+
+template<typename T, typename Field>
+void read_field_column(const nlohmann::json& column, std::vector<T>& values, const Field& static_field) {
+    if (column.size() != values.size()) {
+        throw std::runtime_error(std::string("column '") + static_field.name + "' does not match entity count");
+    }
+    for (size_t index = 0; index < values.size(); ++index) {
+        values[index].*(static_field.member) = column[index].template get<static_field_type<Field>>();
+    }
+}
+
+template<typename T>
+SerializeFn build_store_column_serialize() {
+    return [](const void* instance) -> nlohmann::json {
+        const auto* store = static_cast<const ComponentStore<T>*>(instance);
+        nlohmann::json result = nlohmann::json::object();
+        result.emplace("entities", store->index_to_entity_);
+
+        std::apply([&result, store](const auto&... static_fields) {
+            (result.emplace(static_fields.name, write_field_column(store->dense_, static_fields)), ...);
+        }, T::fields());
+
+        return result;
+    };
+}
+
+template<typename T>
+DeserializeFn build_store_column_deserialize() {
+    return [](const nlohmann::json& json, void* instance, LoadContext& context) {
+        auto* store = static_cast<ComponentStore<T>*>(instance);
+        const auto& remap = context.entity_remap;
+        const auto& entities = json.at("entities");
+
+        std::vector<T> values(entities.size());
+        std::apply([&json, &values](const auto&... static_fields) {
+            (read_field_column(json.at(static_fields.name), values, static_fields), ...);
+        }, T::fields());
+
+        for (size_t index = 0; index < values.size(); ++index) {
+            store->insert(remap.at(entities[index].template get<uint32_t>()), std::move(values[index]));
+        }
+    };
+}
+
+template<typename T>
+SerializeFn build_store_column_delta_serialize() {
+    return [](const void* instance) -> nlohmann::json {
+        const auto* store = static_cast<const ComponentStore<T>*>(instance);
+        require_store_baseline(*store);
+        std::vector<uint32_t> entities;
+        std::vector<T> values;
+
+        store->each_change([&entities, &values, store](uint32_t entity, ComponentChange change) {
+            if (change != ComponentChange::removed) {
+                entities.push_back(entity);
+                values.push_back(store->get(entity));
+            }
+        });
+
+        nlohmann::json upserted = nlohmann::json::object();
+        upserted.emplace("entities", entities);
+        std::apply([&upserted, &values](const auto&... static_fields) {
+            (upserted.emplace(static_fields.name, write_field_column(values, static_fields)), ...);
+        }, T::fields());
+
+        return {{"upsert", std::move(upserted)}, {"remove", write_store_removals(*store)}};
+    };
+}
+
+template<typename T>
+DeserializeFn build_store_column_delta_apply() {
+    return [](const nlohmann::json& json, void* instance, LoadContext& context) {
+        auto* store = static_cast<ComponentStore<T>*>(instance);
+        apply_store_removals(json.at("remove"), *store, context.entity_remap);
+
+        const auto& upserted = json.at("upsert");
+        const auto& entities = upserted.at("entities");
+        std::vector<T> values(entities.size());
+        std::apply([&upserted, &values](const auto&... static_fields) {
+            (read_field_column(upserted.at(static_fields.name), values, static_fields), ...);
+        }, T::fields());
+
+        for (size_t index = 0; index < values.size(); ++index) {
+            uint32_t entity = context.entity_remap.at(entities[index].template get<uint32_t>());
+            upsert_component(*store, entity, std::move(values[index]));
+        }
+    };
+}
+
+template<typename T>
+RegistryEntry describe_component_columns(const char* name, const RegistryEntry& value_entry) {
+    std::string value_type_name = value_entry.schema["name"].get<std::string>();
+
+    std::apply([](const auto&... static_fields) {
+        ((std::string_view(static_fields.name) == "entities"
+            ? throw std::runtime_error("field name 'entities' is reserved by component columns")
+            : void()), ...);
+    }, T::fields());
+
+    nlohmann::json schema = {
+        {"name", name},
+        {"container", "component_columns"},
+        {"value_type", value_type_name}
+    };
+
+    return RegistryEntry{
+        std::move(schema),
+        build_store_column_serialize<T>(),
+        build_store_column_deserialize<T>(),
+        {"EntityRegistry"},
+        {build_store_column_delta_serialize<T>(), build_store_column_delta_apply<T>(), build_store_rebase<T>()}
     };
 }
 
@@ -1,14 +1,25 @@
 #pragma once
 
+#include <cask/ecs/component_store.hpp>
+#include <cask/ecs/entity_compactor.hpp>
 #include <cask/ecs/entity_table.hpp>
 #include <cask/identity/entity_registry.hpp>
 #include <cask/identity/uuid.hpp>
 #include <cask/schema/serialization_registry.hpp>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
 namespace cask {
 
+inline uint32_t resolve_entity(const std::string& uuid_string, EntityRegistry& registry, EntityTable& table) {
+    auto parsed = uuids::uuid::from_string(uuid_string);
+    if (!parsed.has_value()) {
+        throw std::runtime_error("invalid UUID string: " + uuid_string);
+    }
+    return registry.resolve(parsed.value(), table);
+}
+
 inline SerializeFn build_entity_registry_serialize() {
     return [](const void* instance) -> nlohmann::json {
         const auto* registry = static_cast<const EntityRegistry*>(instance);
@@ -23,24 +34,79 @@ inline SerializeFn build_entity_registry_serialize() {
 }
 
 inline DeserializeFn build_entity_registry_deserialize(EntityTable& table) {
-    return [&table](const nlohmann::json& data, void* instance, const nlohmann::json&) -> nlohmann::json {
+    return [&table](const nlohmann::json& data, void* instance, LoadContext& context) {
         auto* registry = static_cast<EntityRegistry*>(instance);
-        nlohmann::json remap = nlohmann::json::object();
+        auto& remap = context.entity_remap;
 
         for (const auto& [uuid_string, file_local_id] : data.items()) {
+            remap.set(file_local_id.get<uint32_t>(), resolve_entity(uuid_string, *registry, table));
+        }
+    };
+}
+
+inline SerializeFn build_entity_registry_delta_serialize() {
+    return [](const void* instance) -> nlohmann::json {
+        const auto* registry = static_cast<const EntityRegistry*>(instance);
+        if (!registry->tracking_) {
+            throw std::runtime_error("entity registry delta saved without a rebased baseline");
+        }
+        nlohmann::json upserted = nlohmann::json::object();
+        nlohmann::json removed = nlohmann::json::object();
+
+        registry->each_change([&upserted, &removed](const UUID& uuid, uint32_t entity, ComponentChange change) {
+            auto& section = change == ComponentChange::removed ? removed : upserted;
+            section[uuids::to_string(uuid)] = entity;
+        });
+
+        return {{"upsert", std::move(upserted)}, {"remove", std::move(removed)}};
+    };
+}
+
+inline void drop_entity(EntityRegistry& registry, EntityTable& table, const EntityCompactor* compactor, uint32_t entity) {
+    if (!compactor) {
+        throw std::runtime_error("entity registry deltas that remove entities need an EntityCompactor");
+    }
+    for (const auto& entry : compactor->entries_) {
+        entry.fn(entry.store, entity);
+    }
+    registry.remove(entity);
+    table.destroy(entity);
+}
+
+// A removed entity's file id can be reused by an upserted one in the same delta, and the
+// store deltas then only carry the upsert, so its components are dropped here instead.
+inline DeserializeFn build_entity_registry_delta_apply(EntityTable& table, const EntityCompactor* compactor) {
+    return [&table, compactor](const nlohmann::json& data, void* instance, LoadContext& context) {
+        auto* registry = static_cast<EntityRegistry*>(instance);
+        auto& remap = context.entity_remap;
+
+        for (const auto& [uuid_string, file_local_id] : data.at("remove").items()) {
             auto parsed = uuids::uuid::from_string(uuid_string);
             if (!parsed.has_value()) {
                 throw std::runtime_error("invalid UUID string: " + uuid_string);
             }
-            uint32_t runtime_id = registry->resolve(parsed.value(), table);
-            remap[std::to_string(file_local_id.get<uint32_t>())] = runtime_id;
+            auto found = registry->uuid_to_entity_.find(parsed.value());
+            if (found == registry->uuid_to_entity_.end()) {
+                continue;
+            }
+            uint32_t runtime_id = found->second;
+            remap.set(file_local_id.get<uint32_t>(), runtime_id);
+            drop_entity(*registry, table, compactor, runtime_id);
         }
 
-        return {{"entity_remap", remap}};
+        for (const auto& [uuid_string, file_local_id] : data.at("upsert").items()) {
+            remap.set(file_local_id.get<uint32_t>(), resolve_entity(uuid_string, *registry, table));
+        }
     };
 }
 
-inline RegistryEntry describe_entity_registry(const char* name, EntityTable& table) {
+inline RebaseFn build_entity_registry_rebase() {
+    return [](void* instance) {
+        static_cast<EntityRegistry*>(instance)->rebase();
+    };
+}
+
+inline RegistryEntry describe_entity_registry(const char* name, EntityTable& table, const EntityCompactor* compactor) {
     nlohmann::json schema = {
         {"name", name},
         {"type", "entity_registry"}
@@ -50,8 +116,17 @@ inline RegistryEntry describe_entity_registry(const char* name, EntityTable& tab
         std::move(schema),
         build_entity_registry_serialize(),
         build_entity_registry_deserialize(table),
-        {}
+        {},
+        {build_entity_registry_delta_serialize(), build_entity_registry_delta_apply(table, compactor), build_entity_registry_rebase()}
     };
 }
 
+inline RegistryEntry describe_entity_registry(const char* name, EntityTable& table) {
+    return describe_entity_registry(name, table, nullptr);
+}
+
+inline RegistryEntry describe_entity_registry(const char* name, const EntityCompactor& compactor) {
+    return describe_entity_registry(name, *compactor.table_, &compactor);
+}
+
 }
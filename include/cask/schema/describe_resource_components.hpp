@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cask/ecs/component_store.hpp>
+#include <cask/resource/resource_components.hpp>
 #include <cask/resource/resource_handle.hpp>
 #include <cask/resource/resource_store.hpp>
 #include <cask/schema/serialization_registry.hpp>
@@ -23,20 +24,17 @@ SerializeFn build_resource_component_serialize(const ResourceStore<T>& resource_
 }
 
 template<typename T>
-DeserializeFn build_resource_component_deserialize(const char* sources_name) {
-    std::string remap_key = resource_remap_key(sources_name);
-    return [remap_key](const nlohmann::json& json, void* instance, const nlohmann::json& context) -> nlohmann::json {
+DeserializeFn build_resource_component_deserialize(const char* sources_name, ResourceStore<T>& resource_store) {
+    return [sources = std::string(sources_name), &resource_store](const nlohmann::json& json, void* instance, LoadContext& context) {
         auto* store = static_cast<ComponentStore<ResourceHandle<T>>*>(instance);
-        const auto& entity_remap = context.at("entity_remap");
-        const auto& resource_remap = context.at(remap_key);
+        const auto& entity_remap = context.entity_remap;
+        const auto& resource_remap = context.resource_remaps.at(sources);
 
         for (const auto& [entity_key, resource_key] : json.items()) {
-            uint32_t entity = entity_remap.at(entity_key).template get<uint32_t>();
-            uint32_t handle_value = resource_remap.at(resource_key).template get<uint32_t>();
-            store->insert(entity, ResourceHandle<T>{handle_value});
+            uint32_t entity = entity_remap.at(parse_entity_id(entity_key));
+            uint32_t handle_value = resource_remap.at(resource_key.template get_ref<const std::string&>());
+            insert_resource(*store, resource_store, entity, resource_store.handle(handle_value));
         }
-
-        return nlohmann::json::object();
     };
 }
 
@@ -48,12 +46,14 @@ RegistryEntry describe_resource_components(const char* name, const char* sources
         {"value_type", "resource_handle"}
     };
 
-    return RegistryEntry{
+    RegistryEntry entry{
         std::move(schema),
         build_resource_component_serialize<T>(store),
-        build_resource_component_deserialize<T>(sources_name),
+        build_resource_component_deserialize<T>(sources_name, store),
         {"EntityRegistry", std::string(sources_name)}
     };
+    entry.shared_state = {&store};
+    return entry;
 }
 
 }
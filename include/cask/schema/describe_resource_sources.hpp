@@ -4,10 +4,23 @@
 #include <cask/resource/resource_sources.hpp>
 #include <cask/resource/resource_store.hpp>
 #include <cask/schema/serialization_registry.hpp>
+#include <cask/task/worker_pool.hpp>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace cask {
 
+// load_parallel creates every remap before dispatching, so concurrent sections only ever look
+// their remap up and never insert into resource_remaps.
+inline ResourceRemap& resource_remap(LoadContext& context, const std::string& registration_name) {
+    auto found = context.resource_remaps.find(registration_name);
+    if (found != context.resource_remaps.end()) {
+        return found->second;
+    }
+    return context.resource_remaps[registration_name];
+}
+
 template<typename T>
 SerializeFn build_resource_sources_serialize() {
     return [](const void* instance) -> nlohmann::json {
@@ -24,36 +37,82 @@ SerializeFn build_resource_sources_serialize() {
 
 template<typename T>
 DeserializeFn build_resource_sources_deserialize(const std::string& registration_name, ResourceStore<T>& store, ResourceLoaderRegistry<T>& registry) {
-    return [registration_name, &store, &registry](const nlohmann::json& data, void* instance, const nlohmann::json&) -> nlohmann::json {
+    return [registration_name, &store, &registry](const nlohmann::json& data, void* instance, LoadContext& context) {
         auto* sources = static_cast<ResourceSources<T>*>(instance);
-        nlohmann::json remap = nlohmann::json::object();
+        auto& remap = resource_remap(context, registration_name);
 
         for (const auto& [key, entry_json] : data.items()) {
-            std::string loader_name = entry_json["loader"].get<std::string>();
+            const auto& loader_name = entry_json["loader"].template get_ref<const std::string&>();
             const auto& loader = registry.get(loader_name);
             T loaded = loader(entry_json);
             auto handle = store.store(key, std::move(loaded));
             sources->entries[key] = entry_json;
             remap[key] = handle.value;
         }
-
-        return {{resource_remap_key(registration_name), remap}};
     };
 }
 
 template<typename T>
-RegistryEntry describe_resource_sources(const char* name, ResourceStore<T>& store, ResourceLoaderRegistry<T>& registry) {
-    nlohmann::json schema = {
+DeserializeFn build_parallel_resource_sources_deserialize(const std::string& registration_name, ResourceStore<T>& store, ResourceLoaderRegistry<T>& registry, WorkerPool& pool) {
+    return [registration_name, &store, &registry, &pool](const nlohmann::json& data, void* instance, LoadContext& context) {
+        auto* sources = static_cast<ResourceSources<T>*>(instance);
+        auto& remap = resource_remap(context, registration_name);
+
+        std::vector<std::string> keys;
+        std::vector<const nlohmann::json*> specs;
+        std::vector<const typename ResourceLoaderRegistry<T>::LoaderFn*> loaders;
+        for (const auto& [key, entry_json] : data.items()) {
+            keys.push_back(key);
+            specs.push_back(&entry_json);
+            loaders.push_back(&registry.get(entry_json["loader"].template get_ref<const std::string&>()));
+        }
+
+        std::vector<std::optional<T>> loaded(keys.size());
+        TaskGroup group(pool);
+        for (size_t index = 0; index < keys.size(); ++index) {
+            group.run([&loaded, &specs, &loaders, index] {
+                loaded[index].emplace((*loaders[index])(*specs[index]));
+            });
+        }
+        group.wait();
+
+        for (size_t index = 0; index < keys.size(); ++index) {
+            auto handle = store.store(keys[index], std::move(*loaded[index]));
+            sources->entries[keys[index]] = *specs[index];
+            remap[keys[index]] = handle.value;
+        }
+    };
+}
+
+inline nlohmann::json resource_sources_schema(const char* name) {
+    return {
         {"name", name},
         {"type", "resource_sources"}
     };
+}
 
-    return RegistryEntry{
-        std::move(schema),
+template<typename T>
+RegistryEntry describe_resource_sources(const char* name, ResourceStore<T>& store, ResourceLoaderRegistry<T>& registry) {
+    RegistryEntry entry{
+        resource_sources_schema(name),
         build_resource_sources_serialize<T>(),
         build_resource_sources_deserialize<T>(std::string(name), store, registry),
         {}
     };
+    entry.shared_state = {&store};
+    return entry;
+}
+
+template<typename T>
+RegistryEntry describe_resource_sources(const char* name, ResourceStore<T>& store, ResourceLoaderRegistry<T>& registry, WorkerPool& pool) {
+    RegistryEntry entry{
+        resource_sources_schema(name),
+        build_resource_sources_serialize<T>(),
+        build_parallel_resource_sources_deserialize<T>(std::string(name), store, registry, pool),
+        {}
+    };
+    entry.shared_state = {&store};
+    return entry;
 }
 
 }
@@ -1,109 +1,207 @@
 #pragma once
 
 #include <cask/schema/serialization_registry.hpp>
+#include <cstdint>
 #include <functional>
 #include <nlohmann/json.hpp>
-#include <queue>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace cask {
 
 using ComponentResolver = std::function<void*(const std::string&)>;
 
-inline std::vector<std::string> topological_sort(
-    const std::vector<std::string>& names,
-    const std::unordered_map<std::string, std::vector<std::string>>& dep_map
-) {
-    std::unordered_map<std::string, int> in_degree;
-    std::unordered_map<std::string, std::vector<std::string>> adjacency;
+// Sorts ahead of "components", so a streamed delta is rejected before any section is applied.
+inline constexpr const char* DELTA_KEY = "_delta";
+
+struct ComponentTable {
+    std::vector<void*> instances_;
 
-    for (const auto& name : names) {
-        in_degree[name] = 0;
+    void bind(uint32_t id, void* instance) {
+        if (id >= instances_.size()) {
+            instances_.resize(static_cast<size_t>(id) + 1, nullptr);
+        }
+        instances_[id] = instance;
     }
 
-    for (const auto& name : names) {
-        auto found = dep_map.find(name);
-        if (found == dep_map.end()) {
-            continue;
+    void* at(uint32_t id) const {
+        return id < instances_.size() ? instances_[id] : nullptr;
+    }
+
+    void* require(uint32_t id, const SerializationRegistry& registry) const {
+        void* instance = at(id);
+        if (!instance) {
+            throw std::runtime_error("no instance bound for component " + registry.name(id));
         }
-        for (const auto& dep : found->second) {
-            adjacency[dep].push_back(name);
-            in_degree[name]++;
+        return instance;
+    }
+
+    // Checked up front so a missing instance fails the load before any component is touched.
+    void require_all(const std::vector<uint32_t>& ids, const SerializationRegistry& registry) const {
+        for (uint32_t id : ids) {
+            require(id, registry);
         }
     }
+};
+
+inline ComponentTable resolve_components(
+    const SerializationRegistry& registry,
+    const std::vector<uint32_t>& ids,
+    const ComponentResolver& resolver
+) {
+    ComponentTable table;
+    for (uint32_t id : ids) {
+        table.bind(id, resolver(registry.name(id)));
+    }
+    return table;
+}
+
+struct ComponentGraph {
+    std::vector<uint32_t> ids_;
+    std::vector<bool> present_;
+    std::vector<std::vector<uint32_t>> dependents_;
+    std::vector<uint32_t> in_degree_;
+
+    explicit ComponentGraph(size_t registered)
+        : present_(registered, false), dependents_(registered), in_degree_(registered, 0) {}
 
-    std::queue<std::string> ready;
-    for (const auto& [name, degree] : in_degree) {
-        if (degree == 0) {
-            ready.push(name);
+    void add(uint32_t id) {
+        ids_.push_back(id);
+        present_[id] = true;
+    }
+
+    void depend(uint32_t id, uint32_t dependency) {
+        dependents_[dependency].push_back(id);
+        in_degree_[id]++;
+    }
+
+    std::vector<uint32_t> sorted() const {
+        auto in_degree = in_degree_;
+        std::vector<uint32_t> order;
+        order.reserve(ids_.size());
+        for (uint32_t id : ids_) {
+            if (in_degree[id] == 0) {
+                order.push_back(id);
+            }
+        }
+
+        for (size_t next = 0; next < order.size(); ++next) {
+            for (uint32_t dependent : dependents_[order[next]]) {
+                if (--in_degree[dependent] == 0 && present_[dependent]) {
+                    order.push_back(dependent);
+                }
+            }
+        }
+
+        if (order.size() != ids_.size()) {
+            throw std::runtime_error("circular dependency detected in component graph");
         }
+
+        return order;
     }
+};
 
-    std::vector<std::string> sorted;
-    while (!ready.empty()) {
-        auto current = ready.front();
-        ready.pop();
-        sorted.push_back(current);
+inline std::vector<uint32_t> read_component_ids(
+    const nlohmann::json& components_section,
+    const SerializationRegistry& registry
+) {
+    std::vector<uint32_t> ids;
+    ids.reserve(components_section.size());
+    for (const auto& [name, _] : components_section.items()) {
+        ids.push_back(registry.id(name));
+    }
+    return ids;
+}
 
-        auto adj_found = adjacency.find(current);
-        if (adj_found == adjacency.end()) {
+inline void read_dependencies(
+    const nlohmann::json& dependencies_section,
+    const SerializationRegistry& registry,
+    std::vector<std::vector<uint32_t>>& dependencies
+) {
+    for (const auto& [name, deps] : dependencies_section.items()) {
+        auto id = registry.find(name);
+        if (!id) {
             continue;
         }
-        for (const auto& dependent : adj_found->second) {
-            in_degree[dependent]--;
-            if (in_degree[dependent] == 0) {
-                ready.push(dependent);
-            }
+        for (const auto& dep : deps) {
+            dependencies[*id].push_back(registry.id(dep.get_ref<const std::string&>()));
         }
     }
+}
 
-    if (sorted.size() != names.size()) {
-        throw std::runtime_error("circular dependency detected in component graph");
+inline ComponentGraph read_component_graph(
+    const nlohmann::json& file_data,
+    const SerializationRegistry& registry
+) {
+    ComponentGraph graph(registry.size());
+    for (uint32_t id : read_component_ids(file_data.at("components"), registry)) {
+        graph.add(id);
     }
 
-    return sorted;
+    std::vector<std::vector<uint32_t>> dependencies(registry.size());
+    read_dependencies(file_data.at("dependencies"), registry, dependencies);
+    for (uint32_t id = 0; id < dependencies.size(); ++id) {
+        for (uint32_t dependency : dependencies[id]) {
+            graph.depend(id, dependency);
+        }
+    }
+    return graph;
 }
 
-inline nlohmann::json load(
+inline LoadContext load(
     const nlohmann::json& file_data,
     const SerializationRegistry& registry,
-    ComponentResolver resolver
+    const ComponentTable& components
 ) {
-    const auto& dependencies_section = file_data.at("dependencies");
+    if (file_data.value(DELTA_KEY, false)) {
+        throw std::runtime_error("delta saves must be applied with load_delta");
+    }
     const auto& components_section = file_data.at("components");
+    auto graph = read_component_graph(file_data, registry);
+    components.require_all(graph.ids_, registry);
 
-    std::vector<std::string> names;
-    for (const auto& [name, _] : components_section.items()) {
-        names.push_back(name);
-    }
+    LoadContext context;
 
-    std::unordered_map<std::string, std::vector<std::string>> dep_map;
-    for (const auto& [name, deps] : dependencies_section.items()) {
-        std::vector<std::string> dep_list;
-        for (const auto& dep : deps) {
-            dep_list.push_back(dep.get<std::string>());
-        }
-        dep_map[name] = std::move(dep_list);
-    }
+    for (uint32_t id : graph.sorted()) {
+        const auto& entry = registry.get(id);
+        const auto& component_data = components_section.at(registry.name(id));
 
-    auto sorted = topological_sort(names, dep_map);
+        entry.deserialize(component_data, components.require(id, registry), context);
+    }
 
-    nlohmann::json accumulated_context = nlohmann::json::object();
+    return context;
+}
 
-    for (const auto& name : sorted) {
-        const auto& entry = registry.get(name);
-        void* instance = resolver(name);
-        const auto& component_data = components_section.at(name);
+inline void load_delta(
+    const nlohmann::json& patch,
+    const SerializationRegistry& registry,
+    const ComponentTable& components,
+    LoadContext& context
+) {
+    if (!patch.value(DELTA_KEY, false)) {
+        throw std::runtime_error("full saves must be loaded with load");
+    }
+    const auto& components_section = patch.at("components");
+    auto graph = read_component_graph(patch, registry);
+    components.require_all(graph.ids_, registry);
 
-        auto contributions = entry.deserialize(component_data, instance, accumulated_context);
+    for (uint32_t id : graph.sorted()) {
+        const auto& entry = registry.get(id);
+        const auto& apply = entry.delta.apply ? entry.delta.apply : entry.deserialize;
+        const auto& component_data = components_section.at(registry.name(id));
 
-        accumulated_context.merge_patch(contributions);
+        apply(component_data, components.require(id, registry), context);
     }
+}
 
-    return accumulated_context;
+inline LoadContext load(
+    const nlohmann::json& file_data,
+    const SerializationRegistry& registry,
+    ComponentResolver resolver
+) {
+    auto ids = read_component_ids(file_data.at("components"), registry);
+    return load(file_data, registry, resolve_components(registry, ids, resolver));
 }
 
 }
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cask/schema/loader.hpp>
+#include <cask/schema/serialization_registry.hpp>
+#include <cask/task/worker_pool.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cask {
+
+struct ParallelLoad {
+    std::mutex mutex_;
+    std::condition_variable finished_;
+    std::vector<uint32_t> completed_;
+    std::exception_ptr error_;
+
+    void complete(uint32_t id, std::exception_ptr error) {
+        std::lock_guard lock(mutex_);
+        completed_.push_back(id);
+        if (error && !error_) {
+            error_ = error;
+        }
+        finished_.notify_one();
+    }
+
+    bool failed() {
+        std::lock_guard lock(mutex_);
+        return static_cast<bool>(error_);
+    }
+
+    std::vector<uint32_t> wait_for_completed(WorkerPool& pool) {
+        while (true) {
+            {
+                std::lock_guard lock(mutex_);
+                if (!completed_.empty()) {
+                    return std::exchange(completed_, {});
+                }
+            }
+            if (pool.run_one()) {
+                continue;
+            }
+            std::unique_lock lock(mutex_);
+            finished_.wait(lock, [this] { return !completed_.empty(); });
+            return std::exchange(completed_, {});
+        }
+    }
+};
+
+// Sections that mutate the same external state, such as two component stores inserting into one
+// ResourceStore, are chained in topological order so they never run at the same time.
+inline void order_shared_state(ComponentGraph& graph, const SerializationRegistry& registry) {
+    std::unordered_map<const void*, uint32_t> last_writer;
+    for (uint32_t id : graph.sorted()) {
+        for (const void* state : registry.get(id).shared_state) {
+            auto [found, inserted] = last_writer.try_emplace(state, id);
+            if (!inserted) {
+                graph.depend(id, found->second);
+                found->second = id;
+            }
+        }
+    }
+}
+
+inline LoadContext load_parallel(
+    const nlohmann::json& file_data,
+    const SerializationRegistry& registry,
+    const ComponentTable& components,
+    WorkerPool& pool
+) {
+    if (file_data.value(DELTA_KEY, false)) {
+        throw std::runtime_error("delta saves must be applied with load_delta");
+    }
+    const auto& components_section = file_data.at("components");
+    auto graph = read_component_graph(file_data, registry);
+    order_shared_state(graph, registry);
+    components.require_all(graph.ids_, registry);
+
+    LoadContext context;
+    for (uint32_t id : graph.ids_) {
+        const auto& entry = registry.get(id);
+        if (entry.schema.value("type", "") == "resource_sources") {
+            context.resource_remaps[entry.schema.at("name").get<std::string>()];
+        }
+    }
+
+    ParallelLoad state;
+    size_t in_flight = 0;
+    auto& remaining = graph.in_degree_;
+
+    auto dispatch = [&](uint32_t id) {
+        const auto* entry = &registry.get(id);
+        void* instance = components.require(id, registry);
+        const auto& component_data = components_section.at(registry.name(id));
+        ++in_flight;
+        pool.submit([&state, &context, &component_data, id, entry, instance] {
+            std::exception_ptr error;
+            try {
+                entry->deserialize(component_data, instance, context);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            state.complete(id, error);
+        });
+    };
+
+    for (uint32_t id : graph.ids_) {
+        if (remaining[id] == 0) {
+            dispatch(id);
+        }
+    }
+
+    while (in_flight > 0) {
+        auto completed = state.wait_for_completed(pool);
+        in_flight -= completed.size();
+        if (state.failed()) {
+            continue;
+        }
+        for (uint32_t id : completed) {
+            for (uint32_t dependent : graph.dependents_[id]) {
+                if (--remaining[dependent] == 0 && graph.present_[dependent]) {
+                    dispatch(dependent);
+                }
+            }
+        }
+    }
+
+    if (state.error_) {
+        std::rethrow_exception(state.error_);
+    }
+
+    return context;
+}
+
+inline LoadContext load_parallel(
+    const nlohmann::json& file_data,
+    const SerializationRegistry& registry,
+    ComponentResolver resolver,
+    WorkerPool& pool
+) {
+    auto ids = read_component_ids(file_data.at("components"), registry);
+    return load_parallel(file_data, registry, resolve_components(registry, ids, resolver), pool);
+}
+
+}
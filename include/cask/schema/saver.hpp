@@ -2,6 +2,7 @@
 
 #include <cask/schema/loader.hpp>
 #include <cask/schema/serialization_registry.hpp>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
@@ -9,24 +10,72 @@
 namespace cask {
 
 inline nlohmann::json save(
-    const std::vector<std::string>& component_names,
+    const std::vector<uint32_t>& component_ids,
     const SerializationRegistry& registry,
-    ComponentResolver resolver
+    const ComponentTable& components
 ) {
-    nlohmann::json components = nlohmann::json::object();
+    nlohmann::json components_section = nlohmann::json::object();
     nlohmann::json dependencies = nlohmann::json::object();
 
-    for (const auto& name : component_names) {
-        const auto& entry = registry.get(name);
-        void* instance = resolver(name);
-        components[name] = entry.serialize(instance);
+    for (uint32_t id : component_ids) {
+        const auto& entry = registry.get(id);
+        const auto& name = registry.name(id);
+        components_section[name] = entry.serialize(components.require(id, registry));
+
+        if (!entry.dependencies.empty()) {
+            dependencies[name] = entry.dependencies;
+        }
+    }
+
+    return {{"dependencies", dependencies}, {"components", components_section}};
+}
+
+inline nlohmann::json save_delta(
+    const std::vector<uint32_t>& component_ids,
+    const SerializationRegistry& registry,
+    const ComponentTable& components
+) {
+    nlohmann::json components_section = nlohmann::json::object();
+    nlohmann::json dependencies = nlohmann::json::object();
+
+    for (uint32_t id : component_ids) {
+        const auto& entry = registry.get(id);
+        const auto& name = registry.name(id);
+        const auto& serialize = entry.delta.serialize ? entry.delta.serialize : entry.serialize;
+        components_section[name] = serialize(components.require(id, registry));
 
         if (!entry.dependencies.empty()) {
             dependencies[name] = entry.dependencies;
         }
     }
 
-    return {{"dependencies", dependencies}, {"components", components}};
+    return {{DELTA_KEY, true}, {"dependencies", dependencies}, {"components", components_section}};
+}
+
+inline void rebase(
+    const std::vector<uint32_t>& component_ids,
+    const SerializationRegistry& registry,
+    const ComponentTable& components
+) {
+    for (uint32_t id : component_ids) {
+        const auto& entry = registry.get(id);
+        if (entry.delta.rebase) {
+            entry.delta.rebase(components.require(id, registry));
+        }
+    }
+}
+
+inline nlohmann::json save(
+    const std::vector<std::string>& component_names,
+    const SerializationRegistry& registry,
+    ComponentResolver resolver
+) {
+    std::vector<uint32_t> ids;
+    ids.reserve(component_names.size());
+    for (const auto& name : component_names) {
+        ids.push_back(registry.id(name));
+    }
+    return save(ids, registry, resolve_components(registry, ids, resolver));
 }
 
 }
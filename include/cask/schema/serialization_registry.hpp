@@ -1,45 +1,155 @@
 #pragma once
 
+#include <cask/container/string_map.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <optional>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace cask {
 
-using SerializeFn = std::function<nlohmann::json(const void*)>;
-using DeserializeFn = std::function<nlohmann::json(const nlohmann::json&, void*, const nlohmann::json&)>;
+inline constexpr uint32_t UNMAPPED_ENTITY = std::numeric_limits<uint32_t>::max();
 
-inline std::string resource_remap_key(const std::string& name) {
-    return "resource_remap_" + name;
+inline uint32_t parse_entity_id(std::string_view key) {
+    uint32_t entity = 0;
+    auto [end, error] = std::from_chars(key.data(), key.data() + key.size(), entity);
+    if (error != std::errc() || end != key.data() + key.size()) {
+        throw std::runtime_error("invalid entity id: " + std::string(key));
+    }
+    return entity;
 }
 
+inline constexpr size_t ENTITY_REMAP_DENSE_MINIMUM = 1024;
+inline constexpr size_t ENTITY_REMAP_DENSE_SLACK = 4;
+
+// File-local ids index a dense table while they stay within a small multiple of the number of
+// mapped entities; ids beyond that, which a hostile or very sparse file can name, go to a hash map.
+struct EntityRemap {
+    std::vector<uint32_t> table_;
+    std::unordered_map<uint32_t, uint32_t> sparse_;
+    size_t size_ = 0;
+
+    void set(uint32_t file_entity, uint32_t runtime_entity) {
+        if (file_entity >= table_.size()) {
+            size_t limit = std::max(ENTITY_REMAP_DENSE_MINIMUM, (size_ + 1) * ENTITY_REMAP_DENSE_SLACK);
+            if (file_entity >= limit) {
+                size_ += sparse_.insert_or_assign(file_entity, runtime_entity).second;
+                return;
+            }
+            grow(std::min(limit, std::max(static_cast<size_t>(file_entity) + 1, table_.size() * 2)));
+        }
+        size_ += table_[file_entity] == UNMAPPED_ENTITY;
+        table_[file_entity] = runtime_entity;
+    }
+
+    void grow(size_t size) {
+        table_.resize(size, UNMAPPED_ENTITY);
+        std::erase_if(sparse_, [this](const auto& entry) {
+            if (entry.first >= table_.size()) {
+                return false;
+            }
+            table_[entry.first] = entry.second;
+            return true;
+        });
+    }
+
+    uint32_t lookup(uint32_t file_entity) const {
+        if (file_entity < table_.size()) {
+            return table_[file_entity];
+        }
+        auto found = sparse_.find(file_entity);
+        return found != sparse_.end() ? found->second : UNMAPPED_ENTITY;
+    }
+
+    bool has(uint32_t file_entity) const {
+        return lookup(file_entity) != UNMAPPED_ENTITY;
+    }
+
+    uint32_t at(uint32_t file_entity) const {
+        uint32_t runtime_entity = lookup(file_entity);
+        if (runtime_entity == UNMAPPED_ENTITY) {
+            throw std::runtime_error("entity_remap missing entity: " + std::to_string(file_entity));
+        }
+        return runtime_entity;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+};
+
+using ResourceRemap = StringMap<uint32_t>;
+
+struct LoadContext {
+    EntityRemap entity_remap;
+    StringMap<ResourceRemap> resource_remaps;
+};
+
+using SerializeFn = std::function<nlohmann::json(const void*)>;
+using DeserializeFn = std::function<void(const nlohmann::json&, void*, LoadContext&)>;
+using RebaseFn = std::function<void(void*)>;
+
+struct DeltaEntry {
+    SerializeFn serialize;
+    DeserializeFn apply;
+    RebaseFn rebase;
+};
+
 struct RegistryEntry {
     nlohmann::json schema;
     SerializeFn serialize;
     DeserializeFn deserialize;
     std::vector<std::string> dependencies;
+    DeltaEntry delta{};
+    std::vector<const void*> shared_state{};
 };
 
 struct SerializationRegistry {
-    std::unordered_map<std::string, RegistryEntry> entries_;
+    NameTable<RegistryEntry> entries_;
 
-    void add(const std::string& name, RegistryEntry entry) {
-        entries_.emplace(name, std::move(entry));
+    uint32_t add(std::string_view name, RegistryEntry entry) {
+        return entries_.add(name, std::move(entry));
     }
 
-    const RegistryEntry& get(const std::string& name) const {
+    std::optional<uint32_t> find(std::string_view name) const {
+        return entries_.find(name);
+    }
+
+    uint32_t id(std::string_view name) const {
         auto found = entries_.find(name);
-        if (found == entries_.end()) {
-            throw std::runtime_error("No registry entry for: " + name);
+        if (!found) {
+            throw std::runtime_error("No registry entry for: " + std::string(name));
         }
-        return found->second;
+        return *found;
+    }
+
+    const RegistryEntry& get(std::string_view name) const {
+        return entries_.at(id(name));
+    }
+
+    const RegistryEntry& get(uint32_t id) const {
+        return entries_.at(id);
+    }
+
+    const std::string& name(uint32_t id) const {
+        return entries_.name(id);
+    }
+
+    bool has(std::string_view name) const {
+        return entries_.find(name).has_value();
     }
 
-    bool has(const std::string& name) const {
-        return entries_.find(name) != entries_.end();
+    size_t size() const {
+        return entries_.size();
     }
 };
 
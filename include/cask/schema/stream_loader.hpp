@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cask/schema/loader.hpp>
+#include <cask/schema/serialization_registry.hpp>
+#include <cstdint>
+#include <istream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cask {
+
+struct StreamLoader {
+    const SerializationRegistry& registry_;
+    ComponentTable components_;
+    ComponentResolver resolver_;
+    std::vector<uint32_t> ids_;
+    std::vector<std::vector<uint32_t>> dependencies_;
+    std::vector<bool> loaded_;
+    std::vector<std::pair<uint32_t, nlohmann::json>> pending_;
+    LoadContext context_;
+
+    StreamLoader(const SerializationRegistry& registry, ComponentTable components, ComponentResolver resolver = {})
+        : registry_(registry),
+          components_(std::move(components)),
+          resolver_(std::move(resolver)),
+          dependencies_(registry.size()),
+          loaded_(registry.size(), false) {}
+
+    bool ready(uint32_t id) const {
+        for (uint32_t dependency : dependencies_[id]) {
+            if (!loaded_[dependency]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void dispatch(uint32_t id, const nlohmann::json& component_data) {
+        const auto& entry = registry_.get(id);
+        void* instance = resolver_ ? resolver_(registry_.name(id)) : components_.at(id);
+        if (!instance) {
+            throw std::runtime_error("no instance bound for component " + registry_.name(id));
+        }
+        entry.deserialize(component_data, instance, context_);
+        loaded_[id] = true;
+    }
+
+    void drain() {
+        bool progressed = true;
+        while (progressed) {
+            progressed = false;
+            for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+                if (ready(it->first)) {
+                    auto id = it->first;
+                    auto component_data = std::move(it->second);
+                    pending_.erase(it);
+                    dispatch(id, component_data);
+                    progressed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    void receive_component(const std::string& name, nlohmann::json component_data) {
+        uint32_t id = registry_.id(name);
+        for (const auto& dependency : registry_.get(id).dependencies) {
+            dependencies_[id].push_back(registry_.id(dependency));
+        }
+        ids_.push_back(id);
+        pending_.emplace_back(id, std::move(component_data));
+        drain();
+    }
+
+    void receive_dependencies(const nlohmann::json& dependencies_section) {
+        read_dependencies(dependencies_section, registry_, dependencies_);
+        drain();
+    }
+
+    void finish() {
+        ComponentGraph graph(registry_.size());
+        for (uint32_t id : ids_) {
+            graph.add(id);
+        }
+        for (uint32_t id = 0; id < dependencies_.size(); ++id) {
+            for (uint32_t dependency : dependencies_[id]) {
+                graph.depend(id, dependency);
+            }
+        }
+        graph.sorted();
+    }
+};
+
+inline LoadContext load_stream(
+    std::istream& input,
+    StreamLoader& loader
+) {
+    using parse_event = nlohmann::json::parse_event_t;
+
+    std::string section;
+    std::string component_name;
+
+    nlohmann::json::parser_callback_t callback = [&](int depth, parse_event event, nlohmann::json& parsed) -> bool {
+        if (event == parse_event::key && depth == 1) {
+            section = parsed.get<std::string>();
+            return true;
+        }
+        if (section == "components" && depth == 2) {
+            if (event == parse_event::key) {
+                component_name = parsed.get<std::string>();
+                return true;
+            }
+            if (event == parse_event::object_end || event == parse_event::array_end || event == parse_event::value) {
+                loader.receive_component(component_name, std::move(parsed));
+                return false;
+            }
+        }
+        if (section == DELTA_KEY && depth == 1 && event == parse_event::value && parsed == true) {
+            throw std::runtime_error("delta saves must be applied with load_delta");
+        }
+        if (section == "dependencies" && depth == 1 && event == parse_event::object_end) {
+            loader.receive_dependencies(parsed);
+        }
+        return true;
+    };
+
+    auto skeleton = nlohmann::json::parse(input, callback);
+    if (!skeleton.contains("components")) {
+        throw std::runtime_error("scene stream has no components section");
+    }
+    loader.finish();
+
+    return std::move(loader.context_);
+}
+
+inline LoadContext load_stream(
+    std::istream& input,
+    const SerializationRegistry& registry,
+    const ComponentTable& components
+) {
+    StreamLoader loader{registry, components};
+    return load_stream(input, loader);
+}
+
+inline LoadContext load_stream(
+    std::istream& input,
+    const SerializationRegistry& registry,
+    ComponentResolver resolver
+) {
+    StreamLoader loader{registry, ComponentTable{}, std::move(resolver)};
+    return load_stream(input, loader);
+}
+
+}
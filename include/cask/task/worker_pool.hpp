@@ -0,0 +1,149 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cask {
+
+using Task = std::function<void()>;
+
+struct WorkerPool {
+    std::vector<std::thread> threads_;
+    std::deque<Task> tasks_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+    bool stopping_ = false;
+
+    explicit WorkerPool(size_t thread_count) {
+        threads_.reserve(thread_count);
+        for (size_t index = 0; index < thread_count; ++index) {
+            threads_.emplace_back([this] { work(); });
+        }
+    }
+
+    WorkerPool() : WorkerPool(default_thread_count()) {}
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        available_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    static size_t default_thread_count() {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    size_t size() const {
+        return threads_.size();
+    }
+
+    void submit(Task task) {
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        available_.notify_one();
+    }
+
+    bool run_one() {
+        Task task;
+        {
+            std::lock_guard lock(mutex_);
+            if (tasks_.empty()) {
+                return false;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+        return true;
+    }
+
+    void work() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock lock(mutex_);
+                available_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+struct TaskGroup {
+    WorkerPool& pool_;
+    std::mutex mutex_;
+    std::condition_variable finished_;
+    size_t pending_ = 0;
+    std::exception_ptr error_;
+
+    explicit TaskGroup(WorkerPool& pool) : pool_(pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(Task task) {
+        {
+            std::lock_guard lock(mutex_);
+            pending_++;
+        }
+        pool_.submit([this, task = std::move(task)] {
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard lock(mutex_);
+            if (error && !error_) {
+                error_ = error;
+            }
+            pending_--;
+            finished_.notify_all();
+        });
+    }
+
+    void wait() {
+        while (true) {
+            {
+                std::lock_guard lock(mutex_);
+                if (pending_ == 0) {
+                    break;
+                }
+            }
+            if (pool_.run_one()) {
+                continue;
+            }
+            std::unique_lock lock(mutex_);
+            finished_.wait(lock, [this] { return pending_ == 0; });
+            break;
+        }
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+};
+
+}
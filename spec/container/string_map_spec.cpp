@@ -0,0 +1,68 @@
+#include <catch2/catch_all.hpp>
+#include <cask/container/string_map.hpp>
+#include <string>
+#include <string_view>
+
+SCENARIO("string maps are looked up without building a string", "[string_map]") {
+    GIVEN("a map keyed by std::string") {
+        cask::StringMap<int> map;
+        map.emplace("brick", 3);
+
+        WHEN("it is searched with a string_view") {
+            std::string_view key = "brick_texture";
+            auto found = map.find(key.substr(0, 5));
+
+            THEN("the entry is found") {
+                REQUIRE(found != map.end());
+                REQUIRE(found->second == 3);
+            }
+        }
+
+        WHEN("it is searched for a missing key") {
+            THEN("nothing is found") {
+                REQUIRE(map.find(std::string_view("stone")) == map.end());
+                REQUIRE_FALSE(map.contains(std::string_view("stone")));
+            }
+        }
+    }
+}
+
+SCENARIO("name tables assign dense ids to names", "[string_map]") {
+    GIVEN("a table with two names") {
+        cask::NameTable<std::string> table;
+        uint32_t position = table.add("Position", "p");
+        uint32_t velocity = table.add("Velocity", "v");
+
+        THEN("ids are assigned in insertion order") {
+            REQUIRE(position == 0);
+            REQUIRE(velocity == 1);
+            REQUIRE(table.size() == 2);
+        }
+
+        THEN("names and values resolve both ways") {
+            REQUIRE(table.find("Velocity") == velocity);
+            REQUIRE(table.name(velocity) == "Velocity");
+            REQUIRE(table.at(position) == "p");
+        }
+
+        THEN("unknown names are not found") {
+            REQUIRE_FALSE(table.find("Health").has_value());
+        }
+
+        WHEN("an existing name is added again") {
+            const std::string* before = &table.at(position);
+            uint32_t again = table.add("Position", "other");
+
+            THEN("the original id and value are kept") {
+                REQUIRE(again == position);
+                REQUIRE(table.at(position) == "p");
+                REQUIRE(table.size() == 2);
+            }
+
+            THEN("references to existing values stay valid") {
+                table.add("Health", "h");
+                REQUIRE(&table.at(position) == before);
+            }
+        }
+    }
+}
@@ -155,3 +155,64 @@ SCENARIO("has returns false after remove", "[component_store]") {
         }
     }
 }
+
+SCENARIO("component store records changes since its baseline", "[component_store]") {
+    GIVEN("a store with two entities and no baseline") {
+        ComponentStore<Position> store;
+        store.insert(1, Position{1.0f, 1.0f});
+        store.insert(2, Position{2.0f, 2.0f});
+
+        THEN("nothing is tracked") {
+            REQUIRE(store.changes_.empty());
+        }
+
+        WHEN("a baseline is taken and the store is edited") {
+            store.rebase();
+            store.modify(1).x = 5.0f;
+            store.insert(3, Position{3.0f, 3.0f});
+            store.remove(2);
+
+            THEN("each entity reports its change") {
+                REQUIRE(store.changes_.size() == 3);
+                REQUIRE(store.changes_.at(1) == ComponentChange::modified);
+                REQUIRE(store.changes_.at(2) == ComponentChange::removed);
+                REQUIRE(store.changes_.at(3) == ComponentChange::inserted);
+            }
+
+            THEN("rebasing clears the changes") {
+                store.rebase();
+                REQUIRE(store.changes_.empty());
+            }
+        }
+
+        WHEN("an entity is inserted and removed within one baseline") {
+            store.rebase();
+            store.insert(3, Position{3.0f, 3.0f});
+            store.remove(3);
+
+            THEN("no change is reported for it") {
+                REQUIRE(store.changes_.empty());
+            }
+        }
+
+        WHEN("an entity is removed and inserted again within one baseline") {
+            store.rebase();
+            store.remove(1);
+            store.insert(1, Position{9.0f, 9.0f});
+
+            THEN("it is reported as modified") {
+                REQUIRE(store.changes_.at(1) == ComponentChange::modified);
+            }
+        }
+
+        WHEN("an entity is only read through a mutable store") {
+            store.rebase();
+            float x = store.get(1).x;
+
+            THEN("it is not reported") {
+                REQUIRE(x == 1.0f);
+                REQUIRE(store.changes_.empty());
+            }
+        }
+    }
+}
@@ -0,0 +1,185 @@
+#include <catch2/catch_all.hpp>
+#include <cask/ecs/world_snapshot.hpp>
+#include <cask/identity/uuid.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct Position {
+    float x;
+    float y;
+};
+
+}
+
+SCENARIO("world snapshots restore stores, entities and identities", "[world_snapshot]") {
+    GIVEN("a world captured into an arena") {
+        EntityTable table;
+        EntityRegistry registry;
+        ComponentStore<Position> positions;
+
+        auto uuid_a = cask::generate_uuid();
+        auto uuid_b = cask::generate_uuid();
+        uint32_t a = registry.resolve(uuid_a, table);
+        uint32_t b = registry.resolve(uuid_b, table);
+        table.add_component(a, 1);
+        positions.insert(a, Position{1.0f, 2.0f});
+        positions.insert(b, Position{3.0f, 4.0f});
+
+        WorldSnapshot snapshot;
+        snapshot.add(table);
+        snapshot.add(registry);
+        snapshot.add(positions);
+
+        SnapshotArena arena(4096);
+        snapshot.capture(arena);
+
+        WHEN("component values change and the snapshot is restored") {
+            positions.get(a).x = 50.0f;
+            snapshot.restore(arena);
+
+            THEN("the values are rolled back") {
+                REQUIRE(positions.get(a).x == 1.0f);
+                REQUIRE(positions.get(b).y == 4.0f);
+            }
+        }
+
+        WHEN("entities are created and destroyed and the snapshot is restored") {
+            uint32_t c = registry.resolve(cask::generate_uuid(), table);
+            positions.insert(c, Position{5.0f, 6.0f});
+            positions.remove(a);
+            registry.remove(b);
+            table.destroy(b);
+            table.remove_component(a, 1);
+            snapshot.restore(arena);
+
+            THEN("the store holds exactly the captured entities") {
+                REQUIRE(positions.dense_.size() == 2);
+                REQUIRE_FALSE(positions.has(c));
+                REQUIRE(positions.get(a).y == 2.0f);
+                REQUIRE(positions.get(b).x == 3.0f);
+            }
+
+            THEN("the entity table is rolled back") {
+                REQUIRE(table.alive(b));
+                REQUIRE_FALSE(table.alive(c));
+                REQUIRE(table.signatures_[a].test(1));
+                REQUIRE(table.create() == c);
+            }
+
+            THEN("identities are rolled back") {
+                REQUIRE(registry.size() == 2);
+                REQUIRE(registry.identify(b) == uuid_b);
+                REQUIRE(registry.resolve(uuid_a, table) == a);
+            }
+        }
+
+        WHEN("the same arena is captured again") {
+            size_t capacity = arena.capacity();
+            size_t size = arena.size_;
+            snapshot.capture(arena);
+
+            THEN("it reuses its storage") {
+                REQUIRE(arena.capacity() == capacity);
+                REQUIRE(arena.size_ == size);
+            }
+        }
+    }
+}
+
+SCENARIO("restoring a snapshot is recorded as changes on tracked stores", "[world_snapshot]") {
+    GIVEN("a tracked store captured after its baseline") {
+        ComponentStore<Position> positions;
+        positions.insert(1, Position{1.0f, 1.0f});
+        positions.insert(2, Position{2.0f, 2.0f});
+        positions.rebase();
+
+        WorldSnapshot snapshot;
+        snapshot.add(positions);
+        SnapshotArena arena;
+        snapshot.capture(arena);
+
+        WHEN("an entity is removed and another inserted before restoring") {
+            positions.remove(2);
+            positions.insert(3, Position{3.0f, 3.0f});
+            snapshot.restore(arena);
+
+            THEN("the rolled back entities are reported relative to the baseline") {
+                REQUIRE(positions.changes_.at(1) == ComponentChange::modified);
+                REQUIRE(positions.changes_.at(2) == ComponentChange::modified);
+                REQUIRE_FALSE(positions.changes_.contains(3));
+            }
+        }
+    }
+}
+
+SCENARIO("snapshot arrays are aligned in memory", "[world_snapshot]") {
+    GIVEN("an arena holding a value followed by an array") {
+        SnapshotArena arena;
+        arena.value<uint8_t>(1);
+        std::vector<double> values{1.0, 2.0, 3.0};
+        arena.array(std::span<const double>(values));
+
+        WHEN("it is read back") {
+            SnapshotReader reader(arena);
+            reader.value<uint8_t>();
+            auto restored = reader.array<double>();
+
+            THEN("the array starts on a snapshot alignment boundary") {
+                REQUIRE(reinterpret_cast<uintptr_t>(restored.data()) % SNAPSHOT_ALIGNMENT == 0);
+                REQUIRE(std::ranges::equal(restored, values));
+            }
+        }
+    }
+}
+
+SCENARIO("restoring a snapshot is recorded as changes on tracked registries", "[world_snapshot]") {
+    GIVEN("a tracked registry captured after its baseline") {
+        EntityTable table;
+        EntityRegistry registry;
+        auto kept = cask::generate_uuid();
+        registry.resolve(kept, table);
+        registry.rebase();
+
+        WorldSnapshot snapshot;
+        snapshot.add(registry);
+        SnapshotArena arena;
+        snapshot.capture(arena);
+
+        WHEN("an identity is added before restoring") {
+            auto added = cask::generate_uuid();
+            registry.resolve(added, table);
+            snapshot.restore(arena);
+
+            THEN("the added identity is no longer reported") {
+                size_t reported = 0;
+                registry.each_change([&reported, &kept](const cask::UUID& uuid, uint32_t, ComponentChange change) {
+                    REQUIRE(uuid == kept);
+                    REQUIRE(change == ComponentChange::modified);
+                    reported++;
+                });
+                REQUIRE(reported == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("restoring a snapshot into a different world fails", "[world_snapshot]") {
+    GIVEN("an arena captured from a single store") {
+        ComponentStore<Position> positions;
+        WorldSnapshot snapshot;
+        snapshot.add(positions);
+        SnapshotArena arena;
+        snapshot.capture(arena);
+
+        THEN("a snapshot with other entries rejects it") {
+            EntityTable table;
+            WorldSnapshot other;
+            other.add(positions);
+            other.add(table);
+            REQUIRE_THROWS_WITH(other.restore(arena), Catch::Matchers::ContainsSubstring("does not match"));
+        }
+    }
+}
@@ -251,3 +251,44 @@ SCENARIO("resolve after remove creates a fresh entity", "[entity_registry]") {
         }
     }
 }
+
+SCENARIO("rebase starts tracking added and removed UUIDs", "[entity_registry]") {
+    GIVEN("a rebased registry with one mapped entity") {
+        EntityRegistry registry;
+        EntityTable table;
+        auto kept = cask::generate_uuid();
+        auto dropped = cask::generate_uuid();
+        auto dropped_entity = registry.resolve(dropped, table);
+        registry.resolve(kept, table);
+        registry.rebase();
+
+        auto changes = [&registry]() {
+            std::unordered_map<cask::UUID, ComponentChange> result;
+            registry.each_change([&result](const cask::UUID& uuid, uint32_t, ComponentChange change) {
+                result[uuid] = change;
+            });
+            return result;
+        };
+
+        WHEN("one UUID is removed and another added") {
+            registry.remove(dropped_entity);
+            auto added = cask::generate_uuid();
+            registry.resolve(added, table);
+
+            THEN("both are reported and the untouched UUID is not") {
+                auto reported = changes();
+                REQUIRE(reported.size() == 2);
+                REQUIRE(reported.at(dropped) == ComponentChange::removed);
+                REQUIRE(reported.at(added) == ComponentChange::inserted);
+            }
+        }
+
+        WHEN("a UUID is added and removed within the same baseline") {
+            registry.remove(registry.resolve(cask::generate_uuid(), table));
+
+            THEN("nothing is reported") {
+                REQUIRE(changes().empty());
+            }
+        }
+    }
+}
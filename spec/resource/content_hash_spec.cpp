@@ -0,0 +1,43 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/content_hash.hpp>
+#include <cask/resource/mesh_data.hpp>
+#include <cask/resource/texture_data.hpp>
+#include <string>
+
+SCENARIO("hash_bytes matches the XXH64 reference values", "[content_hash]") {
+    THEN("the empty input hashes to the published digest") {
+        REQUIRE(cask::hash_bytes("", 0) == 0xEF46DB3751D8E999ULL);
+    }
+
+    THEN("inputs of every tail length hash differently") {
+        std::string text = "the quick brown fox jumps over the lazy dog";
+        REQUIRE(cask::hash_bytes(text.data(), 3) != cask::hash_bytes(text.data(), 4));
+        REQUIRE(cask::hash_bytes(text.data(), 31) != cask::hash_bytes(text.data(), 32));
+        REQUIRE(cask::hash_bytes(text.data(), text.size()) != cask::hash_bytes(text.data(), text.size(), 1));
+    }
+}
+
+SCENARIO("resource content hashes follow their payload", "[content_hash]") {
+    GIVEN("two equal meshes and one that differs only in normals") {
+        MeshData first({0, 0, 0, 1, 0, 0, 0, 1, 0}, {0, 1, 2});
+        MeshData second({0, 0, 0, 1, 0, 0, 0, 1, 0}, {0, 1, 2});
+        MeshData lit({0, 0, 0, 1, 0, 0, 0, 1, 0}, {0, 1, 2}, {0, 0, 1, 0, 0, 1, 0, 0, 1});
+
+        THEN("equal meshes hash equally") {
+            REQUIRE(first.content_hash() == second.content_hash());
+        }
+
+        THEN("a different attribute changes the hash") {
+            REQUIRE(first.content_hash() != lit.content_hash());
+        }
+    }
+
+    GIVEN("textures with the same pixels but different shapes") {
+        TextureData wide(2, 1, 1, {1, 2});
+        TextureData tall(1, 2, 1, {1, 2});
+
+        THEN("their hashes differ") {
+            REQUIRE(wide.content_hash() != tall.content_hash());
+        }
+    }
+}
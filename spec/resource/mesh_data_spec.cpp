@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 #include <cask/resource/mesh_data.hpp>
+#include <cstring>
 
 SCENARIO("valid mesh data can be constructed with positions and indices", "[mesh_data]") {
     GIVEN("positions for 3 vertices and indices for 1 triangle") {
@@ -44,6 +45,22 @@ SCENARIO("construction throws when positions are empty", "[mesh_data]") {
     }
 }
 
+SCENARIO("construction throws when indices reference a missing vertex", "[mesh_data]") {
+    GIVEN("three vertices and an index past the last one") {
+        std::vector<float> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+        std::vector<uint32_t> indices = {0, 1, 3};
+
+        WHEN("mesh data is constructed") {
+            THEN("it throws with a message about indices") {
+                REQUIRE_THROWS_WITH(
+                    MeshData(positions, indices),
+                    Catch::Matchers::ContainsSubstring("indices")
+                );
+            }
+        }
+    }
+}
+
 SCENARIO("construction throws when indices are empty", "[mesh_data]") {
     GIVEN("valid positions and empty indices") {
         std::vector<float> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
@@ -159,3 +176,200 @@ SCENARIO("construction throws when uvs size does not match vertex count", "[mesh
         }
     }
 }
+
+SCENARIO("mesh data builds an interleaved vertex buffer", "[mesh_data]") {
+    GIVEN("a triangle with positions, normals and uvs") {
+        std::vector<float> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+        std::vector<float> normals = {0, 0, 1, 0, 0, 1, 0, 0, 1};
+        std::vector<float> uvs = {0, 0, 1, 0, 0, 1};
+        MeshData mesh(positions, {0, 1, 2}, normals, uvs);
+
+        THEN("no vertex buffer exists until one is built") {
+            REQUIRE_FALSE(mesh.has_vertex_buffer());
+        }
+
+        WHEN("it is interleaved with a packed layout") {
+            auto layout = make_vertex_layout({VertexAttribute::position, VertexAttribute::normal, VertexAttribute::uv});
+            mesh.interleave(layout);
+
+            THEN("the buffer holds one stride per vertex") {
+                REQUIRE(mesh.vertex_buffer().size() == 3 * 32);
+                REQUIRE(mesh.vertex_layout() == layout);
+            }
+
+            THEN("each vertex holds its attributes back to back") {
+                std::vector<float> vertex(8);
+                std::memcpy(vertex.data(), mesh.vertex_buffer().data() + 32, 32);
+                REQUIRE(vertex == std::vector<float>{1, 0, 0, 0, 0, 1, 1, 0});
+            }
+
+            THEN("the buffer counts towards the byte size") {
+                REQUIRE(mesh.byte_size() == (9 + 9 + 6) * sizeof(float) + 3 * sizeof(uint32_t) + 3 * 32);
+            }
+        }
+
+        WHEN("it is interleaved with a padded uv-first layout") {
+            mesh.interleave(make_vertex_layout({VertexAttribute::uv, VertexAttribute::position}, 32));
+
+            THEN("attributes land at their offsets and padding is zeroed") {
+                std::vector<float> vertex(8);
+                std::memcpy(vertex.data(), mesh.vertex_buffer().data() + 64, 32);
+                REQUIRE(vertex == std::vector<float>{0, 1, 0, 1, 0, 0, 0, 0});
+            }
+        }
+    }
+
+    GIVEN("a mesh without normals") {
+        MeshData mesh({0, 0, 0, 1, 0, 0, 0, 1, 0}, {0, 1, 2});
+
+        THEN("a layout requesting normals throws") {
+            REQUIRE_THROWS(mesh.interleave(make_vertex_layout({VertexAttribute::position, VertexAttribute::normal})));
+        }
+
+        THEN("a layout whose element runs past the stride throws without building a buffer") {
+            VertexLayout layout{{{VertexAttribute::position, 4}}, 12};
+            REQUIRE_THROWS(mesh.interleave(layout));
+            REQUIRE_FALSE(mesh.has_vertex_buffer());
+        }
+    }
+}
+
+SCENARIO("mesh data narrows indices to 16 bits only when asked to", "[mesh_data]") {
+    GIVEN("a triangle with small indices") {
+        std::vector<float> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+
+        WHEN("it is built with the default format") {
+            MeshData mesh(positions, {0, 1, 2});
+
+            THEN("the indices stay 32-bit and are readable in place") {
+                REQUIRE(mesh.index_format() == IndexFormat::uint32);
+                REQUIRE(mesh.long_indices().size() == 3);
+                REQUIRE(mesh.indices_raw().data() == mesh.long_indices().data());
+                REQUIRE(mesh.short_indices().empty());
+            }
+        }
+
+        WHEN("it is built with 16-bit indices requested") {
+            MeshFormat format;
+            format.indices = IndexFormat::uint16;
+            MeshData mesh(positions, {0, 1, 2}, {}, {}, format);
+
+            THEN("the indices are stored as 16-bit values") {
+                REQUIRE(mesh.index_format() == IndexFormat::uint16);
+                REQUIRE(mesh.short_indices().size() == 3);
+                REQUIRE(mesh.long_indices().empty());
+            }
+
+            THEN("reading them in place throws and the accessor decodes them") {
+                REQUIRE_THROWS(mesh.indices_raw());
+                REQUIRE(mesh.indices() == std::vector<uint32_t>{0, 1, 2});
+                REQUIRE(mesh.index_count() == 3);
+            }
+        }
+    }
+
+    GIVEN("a mesh indexing past 65535 with 16-bit indices requested") {
+        std::vector<float> positions(65537 * 3, 0.0f);
+        MeshFormat format;
+        format.indices = IndexFormat::uint16;
+        MeshData mesh(positions, {0, 1, 65536}, {}, {}, format);
+
+        THEN("the indices stay 32-bit") {
+            REQUIRE(mesh.index_format() == IndexFormat::uint32);
+            REQUIRE(mesh.indices() == std::vector<uint32_t>{0, 1, 65536});
+        }
+    }
+}
+
+SCENARIO("compact meshes quantize normals and uvs", "[mesh_data]") {
+    GIVEN("a lit, textured triangle") {
+        std::vector<float> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+        std::vector<float> normals = {0, 0, 1, 0, 1, 0, 0, 0, -1};
+        std::vector<float> uvs = {0, 0, 1, 0, 0.5f, 1};
+        MeshData full(positions, {0, 1, 2}, normals, uvs);
+
+        WHEN("it is built as a compact mesh") {
+            MeshData compact = compact_mesh(positions, {0, 1, 2}, normals, uvs);
+
+            THEN("the selected formats are recorded") {
+                REQUIRE(compact.format().normals == NormalFormat::octahedral);
+                REQUIRE(compact.format().uvs == UvFormat::half2);
+                REQUIRE(compact.packed_normals().size() == 6);
+                REQUIRE(compact.packed_uvs().size() == 6);
+            }
+
+            THEN("attributes decode back to float") {
+                REQUIRE(compact.has_normals());
+                REQUIRE(compact.has_uvs());
+                REQUIRE_THROWS(compact.normals_raw());
+                REQUIRE_THROWS(compact.uvs_raw());
+                REQUIRE(compact.uvs() == uvs);
+                auto decoded = compact.normals();
+                for (size_t index = 0; index < normals.size(); ++index) {
+                    REQUIRE(decoded[index] == Catch::Approx(normals[index]).margin(1e-4));
+                }
+            }
+
+            THEN("the payload is smaller than the float form") {
+                REQUIRE(compact.byte_size() == 9 * sizeof(float) + 3 * sizeof(uint16_t) + 6 * sizeof(int16_t) + 6 * sizeof(uint16_t));
+                REQUIRE(compact.byte_size() < full.byte_size());
+            }
+
+            THEN("an interleaved buffer holds decoded floats") {
+                compact.interleave(make_vertex_layout({VertexAttribute::uv}));
+                std::vector<float> vertex(2);
+                std::memcpy(vertex.data(), compact.vertex_buffer().data() + 16, 8);
+                REQUIRE(vertex == std::vector<float>{0.5f, 1});
+            }
+        }
+    }
+}
+
+SCENARIO("half uvs are only stored within the format's tolerance", "[mesh_data]") {
+    GIVEN("uvs that half precision rounds by more than the default tolerance") {
+        std::vector<float> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+        std::vector<float> uvs = {0, 0, 1.9f, 0, 0.5f, 1};
+        MeshFormat format;
+        format.uvs = UvFormat::half2;
+
+        WHEN("a mesh requests half uvs") {
+            MeshData mesh(positions, {0, 1, 2}, {}, uvs, format);
+
+            THEN("the uvs stay float and read back exactly") {
+                REQUIRE(mesh.format().uvs == UvFormat::float2);
+                REQUIRE(mesh.uvs() == uvs);
+            }
+        }
+
+        WHEN("the format allows a coarser tolerance") {
+            format.uv_tolerance = 0.001f;
+            MeshData mesh(positions, {0, 1, 2}, {}, uvs, format);
+
+            THEN("the uvs are stored as halves") {
+                REQUIRE(mesh.format().uvs == UvFormat::half2);
+                REQUIRE(mesh.uvs()[2] == Catch::Approx(1.9f).margin(0.001f));
+            }
+        }
+    }
+}
+
+SCENARIO("mesh data adopts pooled buffers without copying them", "[mesh_data]") {
+    GIVEN("positions, indices and normals already in payload vectors") {
+        cask::PayloadVector<float> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+        cask::PayloadVector<uint32_t> indices = {0, 1, 2};
+        cask::PayloadVector<float> normals = {0, 0, 1, 0, 0, 1, 0, 0, 1};
+        const float* position_buffer = positions.data();
+        const uint32_t* index_buffer = indices.data();
+        const float* normal_buffer = normals.data();
+
+        WHEN("they are moved into a mesh") {
+            MeshData mesh(std::move(positions), std::move(indices), std::move(normals));
+
+            THEN("the mesh keeps the same buffers") {
+                REQUIRE(mesh.positions().data() == position_buffer);
+                REQUIRE(mesh.indices_raw().data() == index_buffer);
+                REQUIRE(mesh.normals_raw().data() == normal_buffer);
+            }
+        }
+    }
+}
@@ -0,0 +1,252 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/mesh_lod.hpp>
+#include <cask/resource/resource_store.hpp>
+#include <cmath>
+
+namespace {
+
+MeshData heightfield(uint32_t size, float amplitude) {
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    for (uint32_t row = 0; row <= size; ++row) {
+        for (uint32_t column = 0; column <= size; ++column) {
+            float x = static_cast<float>(column);
+            float y = static_cast<float>(row);
+            positions.insert(positions.end(), {x, y, amplitude * std::sin(x * 0.5f) * std::cos(y * 0.5f)});
+        }
+    }
+    for (uint32_t row = 0; row < size; ++row) {
+        for (uint32_t column = 0; column < size; ++column) {
+            uint32_t corner = row * (size + 1) + column;
+            indices.insert(indices.end(), {corner, corner + 1, corner + size + 1, corner + 1, corner + size + 2, corner + size + 1});
+        }
+    }
+    return MeshData(positions, indices);
+}
+
+bool has_position(const MeshData& mesh, float x, float y) {
+    const auto& positions = mesh.positions();
+    for (size_t vertex = 0; vertex < mesh.vertex_count(); ++vertex) {
+        if (positions[vertex * 3] == x && positions[vertex * 3 + 1] == y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+SCENARIO("quadric simplification collapses flat regions without error", "[mesh_lod]") {
+    GIVEN("a flat grid of 512 triangles") {
+        MeshData mesh = heightfield(16, 0.0f);
+
+        WHEN("it is simplified to a quarter of its indices") {
+            auto simplified = simplify_mesh(mesh, mesh.index_count() / 4);
+
+            THEN("the index budget is met") {
+                REQUIRE(simplified.mesh.index_count() <= mesh.index_count() / 4);
+                REQUIRE(simplified.mesh.index_count() % 3 == 0);
+            }
+
+            THEN("no geometric error is introduced") {
+                REQUIRE(simplified.error == Catch::Approx(0.0f).margin(1e-4));
+            }
+
+            THEN("the border corners are kept") {
+                REQUIRE(has_position(simplified.mesh, 0, 0));
+                REQUIRE(has_position(simplified.mesh, 16, 0));
+                REQUIRE(has_position(simplified.mesh, 0, 16));
+                REQUIRE(has_position(simplified.mesh, 16, 16));
+            }
+
+            THEN("unused vertices are dropped") {
+                REQUIRE(simplified.mesh.vertex_count() < mesh.vertex_count());
+            }
+        }
+    }
+
+    GIVEN("a curved surface and a tight error limit") {
+        MeshData mesh = heightfield(16, 2.0f);
+
+        WHEN("it is simplified") {
+            auto simplified = simplify_mesh(mesh, 3, 1e-6f);
+
+            THEN("collapses that exceed the limit are refused") {
+                REQUIRE(simplified.mesh.index_count() == mesh.index_count());
+                REQUIRE(simplified.error <= 1e-6f);
+            }
+        }
+    }
+}
+
+SCENARIO("quadric error is a world-space distance", "[mesh_lod]") {
+    GIVEN("a curved surface and the same surface scaled up four times") {
+        MeshData mesh = heightfield(16, 2.0f);
+        std::vector<float> scaled(mesh.positions().begin(), mesh.positions().end());
+        for (float& value : scaled) {
+            value *= 4.0f;
+        }
+        MeshData large(scaled, mesh.indices());
+
+        WHEN("both are simplified to a quarter of their indices") {
+            auto simplified = simplify_mesh(mesh, mesh.index_count() / 4);
+            auto simplified_large = simplify_mesh(large, large.index_count() / 4);
+
+            THEN("the error stays within the surface's amplitude") {
+                REQUIRE(simplified.error > 0.0f);
+                REQUIRE(simplified.error <= 2.0f);
+            }
+
+            THEN("the error scales linearly with the mesh") {
+                REQUIRE(simplified_large.error == Catch::Approx(simplified.error * 4.0f).epsilon(0.05));
+            }
+        }
+    }
+}
+
+SCENARIO("collapses move to the quadric minimum when it exists", "[mesh_lod]") {
+    GIVEN("three unit planes meeting at a point") {
+        MeshQuadric quadric = MeshQuadric::plane(1, 0, 0, -1, 1.0);
+        quadric.add(MeshQuadric::plane(0, 1, 0, -2, 2.0));
+        quadric.add(MeshQuadric::plane(0, 0, 1, -3, 3.0));
+
+        THEN("the minimum is the intersection with no error") {
+            auto minimum = quadric.minimum();
+            REQUIRE(minimum);
+            REQUIRE((*minimum)[0] == Catch::Approx(1.0));
+            REQUIRE((*minimum)[1] == Catch::Approx(2.0));
+            REQUIRE((*minimum)[2] == Catch::Approx(3.0));
+            REQUIRE(quadric.error(*minimum) == Catch::Approx(0.0).margin(1e-9));
+        }
+
+        THEN("the error is the weighted mean squared distance") {
+            REQUIRE(quadric.error({0, 2, 3}) == Catch::Approx(1.0 / 6.0));
+        }
+
+        WHEN("an edge straddles the intersection") {
+            auto [cost, position] = collapse_target(quadric, {0.5, 1.5, 2.5}, {1.5, 2.5, 3.5});
+
+            THEN("the collapse targets the intersection rather than an endpoint") {
+                REQUIRE(cost == Catch::Approx(0.0).margin(1e-9));
+                REQUIRE(position[0] == Catch::Approx(1.0));
+                REQUIRE(position[1] == Catch::Approx(2.0));
+                REQUIRE(position[2] == Catch::Approx(3.0));
+            }
+        }
+    }
+
+    GIVEN("a single plane") {
+        MeshQuadric quadric = MeshQuadric::plane(0, 0, 1, 0, 1.0);
+
+        THEN("there is no unique minimum and the collapse keeps an endpoint") {
+            REQUIRE_FALSE(quadric.minimum());
+            auto [cost, position] = collapse_target(quadric, {0, 0, 1}, {1, 0, 0});
+            REQUIRE(cost == Catch::Approx(0.0));
+            REQUIRE(position == std::array<double, 3>{1, 0, 0});
+        }
+    }
+}
+
+SCENARIO("a lod chain holds progressively coarser levels", "[mesh_lod]") {
+    GIVEN("a curved surface") {
+        MeshData mesh = heightfield(24, 2.0f);
+
+        WHEN("a chain is built with the default ratios") {
+            auto chain = build_lod_chain(mesh);
+
+            THEN("the first level is the source mesh") {
+                REQUIRE(chain.levels_.size() == 4);
+                REQUIRE(chain.levels_[0] == mesh);
+                REQUIRE(chain.distances_[0] == 0.0f);
+            }
+
+            THEN("each level has fewer triangles and no smaller error") {
+                for (size_t level = 1; level < chain.levels_.size(); ++level) {
+                    REQUIRE(chain.levels_[level].index_count() < chain.levels_[level - 1].index_count());
+                    REQUIRE(chain.errors_[level] >= chain.errors_[level - 1]);
+                    REQUIRE(chain.distances_[level] >= chain.distances_[level - 1]);
+                }
+            }
+
+            THEN("the coarsest level is close to its ratio") {
+                REQUIRE(chain.levels_.back().index_count() <= mesh.index_count() / 8);
+            }
+        }
+    }
+}
+
+SCENARIO("small meshes never simplify to an empty level", "[mesh_lod]") {
+    GIVEN("a single quad") {
+        MeshData quad({0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0}, {0, 1, 2, 0, 2, 3});
+
+        WHEN("it is simplified to no indices at all") {
+            auto simplified = simplify_mesh(quad, 0);
+
+            THEN("at least one triangle is kept") {
+                REQUIRE(simplified.mesh.index_count() >= 3);
+            }
+        }
+
+        WHEN("a chain is built with ratios that round to zero triangles") {
+            LodOptions options;
+            options.ratios = {0.5f, 0.1f, 0.01f};
+            auto chain = build_lod_chain(quad, options);
+
+            THEN("every level holds at least one triangle") {
+                REQUIRE_FALSE(chain.levels_.empty());
+                for (const auto& level : chain.levels_) {
+                    REQUIRE(level.index_count() >= 3);
+                }
+            }
+        }
+    }
+
+    GIVEN("a single triangle") {
+        MeshData triangle({0, 0, 0, 1, 0, 0, 0, 1, 0}, {0, 1, 2});
+
+        THEN("a chain holds only the source level") {
+            REQUIRE(build_lod_chain(triangle).levels_.size() == 1);
+        }
+    }
+}
+
+SCENARIO("lod selection picks a level by distance", "[mesh_lod]") {
+    GIVEN("a chain with switch distances 0, 10 and 20") {
+        MeshLodChain chain;
+        chain.levels_ = {heightfield(4, 0.0f), heightfield(2, 0.0f), heightfield(1, 0.0f)};
+        chain.errors_ = {0.0f, 0.01f, 0.02f};
+        chain.distances_ = {0.0f, 10.0f, 20.0f};
+
+        THEN("near entities use the full mesh") {
+            REQUIRE(select_lod(chain, 0.0f) == 0);
+            REQUIRE(select_lod(chain, 9.9f) == 0);
+        }
+
+        THEN("a level is used from its switch distance on") {
+            REQUIRE(select_lod(chain, 10.0f) == 1);
+            REQUIRE(select_lod(chain, 25.0f) == 2);
+            REQUIRE(lod_for_distance(chain, 1000.0f).index_count() == 6);
+        }
+    }
+}
+
+SCENARIO("a lod chain loader stores every level under one key", "[mesh_lod]") {
+    GIVEN("a mesh loader wrapped in a lod chain loader") {
+        auto loader = lod_chain_loader([](const nlohmann::json&) { return heightfield(16, 2.0f); });
+        ResourceStore<MeshLodChain> store;
+
+        WHEN("a chain is loaded and stored") {
+            auto handle = store.store("terrain", loader(nlohmann::json::object()));
+
+            THEN("the key resolves to the whole chain") {
+                REQUIRE(store.key(handle) == "terrain");
+                REQUIRE(store.get(handle).levels_.size() > 1);
+            }
+
+            THEN("the store accounts for every level") {
+                REQUIRE(store.resident_bytes_ == store.get(handle).byte_size());
+                REQUIRE(store.resident_bytes_ > store.get(handle).levels_[0].byte_size());
+            }
+        }
+    }
+}
@@ -0,0 +1,198 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/mesh_optimizer.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+
+using Triangle = std::array<float, 9>;
+
+MeshData unwelded_grid(uint32_t size) {
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (uint32_t row = 0; row < size; ++row) {
+        for (uint32_t column = 0; column < size; ++column) {
+            uint32_t corner = row * (size + 1) + column;
+            triangles.push_back({corner, corner + 1, corner + size + 1});
+            triangles.push_back({corner + 1, corner + size + 2, corner + size + 1});
+        }
+    }
+    std::vector<std::array<uint32_t, 3>> scattered;
+    for (size_t stride = 0; stride < 7; ++stride) {
+        for (size_t index = stride; index < triangles.size(); index += 7) {
+            scattered.push_back(triangles[index]);
+        }
+    }
+
+    std::vector<float> positions;
+    std::vector<float> uvs;
+    std::vector<uint32_t> indices;
+    for (const auto& triangle : scattered) {
+        for (uint32_t grid_vertex : triangle) {
+            float x = static_cast<float>(grid_vertex % (size + 1));
+            float y = static_cast<float>(grid_vertex / (size + 1));
+            indices.push_back(static_cast<uint32_t>(positions.size() / 3));
+            positions.insert(positions.end(), {x, y, 0});
+            uvs.insert(uvs.end(), {x / size, y / size});
+        }
+    }
+    return MeshData(positions, indices, {}, uvs);
+}
+
+std::vector<Triangle> triangles_of(const MeshData& mesh) {
+    std::vector<Triangle> triangles;
+    const auto& indices = mesh.indices();
+    for (size_t index = 0; index < indices.size(); index += 3) {
+        std::array<std::array<float, 3>, 3> corners;
+        for (size_t corner = 0; corner < 3; ++corner) {
+            const float* position = mesh.positions().data() + indices[index + corner] * 3;
+            corners[corner] = {position[0], position[1], position[2]};
+        }
+        auto first = std::min_element(corners.begin(), corners.end());
+        std::rotate(corners.begin(), first, corners.end());
+        Triangle triangle;
+        for (size_t corner = 0; corner < 3; ++corner) {
+            std::copy(corners[corner].begin(), corners[corner].end(), triangle.begin() + corner * 3);
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}
+
+SCENARIO("acmr counts vertex cache misses per triangle", "[mesh_optimizer]") {
+    GIVEN("two triangles sharing an edge") {
+        std::vector<uint32_t> indices = {0, 1, 2, 2, 1, 3};
+
+        WHEN("acmr is computed with a large cache") {
+            float acmr = compute_acmr(indices, 4);
+
+            THEN("only the four distinct vertices miss") {
+                REQUIRE(acmr == Catch::Approx(2.0f));
+            }
+        }
+
+        WHEN("acmr is computed with a cache of one vertex") {
+            float acmr = compute_acmr(indices, 4, 1);
+
+            THEN("only an immediately repeated vertex hits") {
+                REQUIRE(acmr == Catch::Approx(2.5f));
+            }
+        }
+    }
+}
+
+SCENARIO("welding merges vertices with identical attributes", "[mesh_optimizer]") {
+    GIVEN("a grid where every triangle has its own vertices") {
+        MeshData mesh = unwelded_grid(4);
+
+        WHEN("the vertices are welded") {
+            MeshData welded = weld_vertices(mesh);
+
+            THEN("one vertex remains per grid point") {
+                REQUIRE(welded.vertex_count() == 25);
+                REQUIRE(welded.uvs().size() == 50);
+            }
+
+            THEN("the triangles are unchanged") {
+                REQUIRE(triangles_of(welded) == triangles_of(mesh));
+            }
+        }
+    }
+
+    GIVEN("two vertices with the same position but different uvs") {
+        MeshData mesh({0, 0, 0, 0, 0, 0, 1, 0, 0}, {0, 1, 2}, {}, {0, 0, 1, 1, 0, 1});
+
+        WHEN("the vertices are welded") {
+            MeshData welded = weld_vertices(mesh);
+
+            THEN("they are kept apart") {
+                REQUIRE(welded.vertex_count() == 3);
+            }
+        }
+    }
+}
+
+SCENARIO("vertex cache reordering keeps every triangle", "[mesh_optimizer]") {
+    GIVEN("a welded grid in scattered triangle order") {
+        MeshData mesh = weld_vertices(unwelded_grid(16));
+
+        WHEN("the indices are reordered for the vertex cache") {
+            auto indices = optimize_vertex_cache(mesh.indices(), mesh.vertex_count());
+
+            THEN("the index count is unchanged") {
+                REQUIRE(indices.size() == mesh.indices().size());
+            }
+
+            THEN("the acmr improves") {
+                REQUIRE(compute_acmr(indices, mesh.vertex_count()) < compute_acmr(mesh.indices(), mesh.vertex_count()));
+            }
+
+            THEN("the same triangles are drawn") {
+                MeshData reordered(mesh.attribute(VertexAttribute::position), indices, {}, mesh.uvs());
+                REQUIRE(triangles_of(reordered) == triangles_of(mesh));
+            }
+        }
+    }
+}
+
+SCENARIO("vertex fetch reordering numbers vertices by first use", "[mesh_optimizer]") {
+    GIVEN("a mesh whose indices start at the last vertex and skip one") {
+        MeshData mesh({0, 0, 0, 9, 9, 9, 1, 0, 0, 0, 1, 0}, {3, 2, 0}, {}, {});
+
+        WHEN("vertex fetch is optimized") {
+            MeshData fetched = optimize_vertex_fetch(mesh);
+
+            THEN("indices increase in first-use order") {
+                REQUIRE(fetched.indices() == std::vector<uint32_t>{0, 1, 2});
+            }
+
+            THEN("unreferenced vertices are dropped") {
+                REQUIRE(fetched.attribute(VertexAttribute::position) == std::vector<float>{0, 1, 0, 1, 0, 0, 0, 0, 0});
+            }
+        }
+    }
+}
+
+SCENARIO("optimize_mesh reports acmr before and after", "[mesh_optimizer]") {
+    GIVEN("an interleaved unwelded grid") {
+        MeshData mesh = unwelded_grid(16);
+        mesh.interleave(make_vertex_layout({VertexAttribute::position, VertexAttribute::uv}));
+
+        WHEN("the mesh is optimized") {
+            auto result = optimize_mesh(mesh);
+
+            THEN("welding shrinks the vertex count") {
+                REQUIRE(result.vertices_before == 16 * 16 * 6);
+                REQUIRE(result.vertices_after == 17 * 17);
+            }
+
+            THEN("the acmr improves") {
+                REQUIRE(result.acmr_before == Catch::Approx(3.0f));
+                REQUIRE(result.acmr_after < 1.0f);
+            }
+
+            THEN("the triangles are unchanged") {
+                REQUIRE(triangles_of(result.mesh) == triangles_of(mesh));
+            }
+
+            THEN("the vertex buffer is rebuilt with the same layout") {
+                REQUIRE(result.mesh.vertex_layout() == mesh.vertex_layout());
+                REQUIRE(result.mesh.vertex_buffer().size() == 17 * 17 * mesh.vertex_layout().stride);
+            }
+        }
+
+        WHEN("only fetch reordering is enabled") {
+            MeshOptimizeOptions options;
+            options.weld = false;
+            options.reorder_cache = false;
+            auto result = optimize_mesh(mesh, options);
+
+            THEN("the acmr is unchanged") {
+                REQUIRE(result.acmr_after == Catch::Approx(result.acmr_before));
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/payload_allocator.hpp>
+#include <cstdint>
+
+SCENARIO("payload sizes round up to a size class", "[payload_allocator]") {
+    THEN("small requests share the minimum class") {
+        REQUIRE(cask::payload_size_class(1) == 64);
+        REQUIRE(cask::payload_size_class(64) == 64);
+    }
+
+    THEN("larger requests round to a quarter of their power of two") {
+        REQUIRE(cask::payload_size_class(65) == 80);
+        REQUIRE(cask::payload_size_class(1000) == 1024);
+        REQUIRE(cask::payload_size_class(1025) == 1280);
+    }
+}
+
+SCENARIO("a payload pool hands out aligned blocks and reuses freed ones", "[payload_allocator]") {
+    GIVEN("an empty pool") {
+        cask::PayloadPool pool;
+
+        WHEN("a block is allocated") {
+            void* block = pool.allocate(100);
+
+            THEN("it is 64-byte aligned and counted as live") {
+                REQUIRE(reinterpret_cast<uintptr_t>(block) % cask::PAYLOAD_ALIGNMENT == 0);
+                REQUIRE(pool.stats().live_bytes == cask::payload_size_class(100));
+            }
+
+            AND_WHEN("it is freed and a request of the same class follows") {
+                pool.deallocate(block, 100);
+                void* reused = pool.allocate(110);
+
+                THEN("the cached block is returned") {
+                    REQUIRE(reused == block);
+                    REQUIRE(pool.stats().reused_blocks == 1);
+                    REQUIRE(pool.stats().cached_bytes == 0);
+                }
+
+                pool.deallocate(reused, 110);
+            }
+        }
+
+        WHEN("a large block is allocated") {
+            void* block = pool.allocate(cask::LARGE_PAYLOAD_BYTES + 1);
+
+            THEN("it is still aligned") {
+                REQUIRE(reinterpret_cast<uintptr_t>(block) % cask::PAYLOAD_ALIGNMENT == 0);
+            }
+
+            pool.deallocate(block, cask::LARGE_PAYLOAD_BYTES + 1);
+        }
+
+        WHEN("freed blocks are trimmed") {
+            pool.deallocate(pool.allocate(256), 256);
+            pool.trim();
+
+            THEN("nothing stays cached") {
+                REQUIRE(pool.stats().cached_bytes == 0);
+            }
+        }
+    }
+
+    GIVEN("a pool with no room to cache") {
+        cask::PayloadPool pool(0);
+
+        WHEN("a block is freed") {
+            pool.deallocate(pool.allocate(256), 256);
+
+            THEN("it is released instead of cached") {
+                REQUIRE(pool.stats().cached_bytes == 0);
+                REQUIRE(pool.stats().live_bytes == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("payload vectors allocate from the shared pool", "[payload_allocator]") {
+    GIVEN("a payload vector of floats") {
+        cask::PayloadVector<float> values(37, 1.0f);
+
+        THEN("its storage is 64-byte aligned") {
+            REQUIRE(reinterpret_cast<uintptr_t>(values.data()) % cask::PAYLOAD_ALIGNMENT == 0);
+            REQUIRE(values.size() == 37);
+        }
+    }
+}
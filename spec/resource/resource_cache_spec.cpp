@@ -0,0 +1,230 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/resource_cache.hpp>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+struct TempDirectory {
+    std::filesystem::path path;
+
+    TempDirectory() : path(std::filesystem::temp_directory_path() / ("cask_cache_" + std::to_string(std::rand()))) {
+        std::filesystem::create_directories(path);
+    }
+
+    ~TempDirectory() {
+        std::filesystem::remove_all(path);
+    }
+};
+
+void write_file(const std::filesystem::path& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::trunc);
+    file << contents;
+}
+
+template<typename Resource>
+Resource round_trip(const Resource& resource) {
+    cask::BlobWriter writer;
+    resource.write_blob(writer);
+    cask::BlobReader reader(writer.bytes_);
+    return Resource::read_blob(reader);
+}
+
+}
+
+SCENARIO("resources round trip through binary blobs", "[resource_cache]") {
+    GIVEN("a compact mesh with an interleaved buffer") {
+        MeshData mesh = compact_mesh({0, 0, 0, 1, 0, 0, 0, 1, 0}, {0, 1, 2}, {0, 0, 1, 0, 0, 1, 0, 0, 1}, {0, 0, 1, 0, 0, 1});
+        mesh.interleave(make_vertex_layout({VertexAttribute::position, VertexAttribute::uv}));
+
+        WHEN("it is written and read back") {
+            MeshData restored = round_trip(mesh);
+
+            THEN("every stream and format survives") {
+                REQUIRE(restored == mesh);
+                REQUIRE(restored.format() == mesh.format());
+                REQUIRE(restored.index_format() == IndexFormat::uint16);
+                REQUIRE(restored.vertex_layout() == mesh.vertex_layout());
+                REQUIRE(restored.vertex_buffer().size() == mesh.vertex_buffer().size());
+            }
+        }
+    }
+
+    GIVEN("a compressed texture with mips") {
+        std::vector<uint8_t> pixels(8 * 8 * 4, 200);
+        TextureData texture(8, 8, 4, pixels);
+        texture.generate_mips();
+        texture.compress(BlockFormat::bc3);
+
+        WHEN("it is written and read back") {
+            TextureData restored = round_trip(texture);
+
+            THEN("levels and the compressed form survive") {
+                REQUIRE(restored == texture);
+                REQUIRE(restored.compressed_format() == BlockFormat::bc3);
+                REQUIRE(restored.mip_count() == 4);
+            }
+        }
+    }
+
+    GIVEN("a truncated blob") {
+        cask::BlobWriter writer;
+        placeholder_mesh().write_blob(writer);
+        writer.bytes_.resize(writer.bytes_.size() / 2);
+        cask::BlobReader reader(writer.bytes_);
+
+        THEN("reading it throws") {
+            REQUIRE_THROWS_WITH(MeshData::read_blob(reader), Catch::Matchers::ContainsSubstring("truncated"));
+        }
+    }
+}
+
+SCENARIO("blobs that break resource invariants are rejected", "[resource_cache]") {
+    GIVEN("a mesh blob whose indices reference a missing vertex") {
+        cask::BlobWriter writer;
+        writer.value(MeshFormat{});
+        writer.array(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0});
+        writer.array(std::vector<uint32_t>{0, 1, 3});
+        for (int stream = 0; stream < 5; ++stream) {
+            writer.array(std::vector<uint32_t>{});
+        }
+        writer.value<uint32_t>(0);
+        writer.array(std::vector<VertexElement>{});
+        writer.array(std::vector<std::byte>{});
+        cask::BlobReader reader(writer.bytes_);
+
+        THEN("reading it throws") {
+            REQUIRE_THROWS_WITH(MeshData::read_blob(reader), "indices must reference existing vertices");
+        }
+    }
+
+    GIVEN("a mesh blob with an unknown normal format") {
+        cask::BlobWriter writer;
+        placeholder_mesh().write_blob(writer);
+        writer.bytes_[offsetof(MeshFormat, normals)] = std::byte{7};
+        cask::BlobReader reader(writer.bytes_);
+
+        THEN("reading it throws") {
+            REQUIRE_THROWS_WITH(MeshData::read_blob(reader), "mesh format is unknown");
+        }
+    }
+
+    GIVEN("a mesh blob whose vertex buffer does not match its layout") {
+        cask::BlobWriter writer;
+        writer.value(MeshFormat{});
+        writer.array(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0});
+        writer.array(std::vector<uint32_t>{0, 1, 2});
+        for (int stream = 0; stream < 5; ++stream) {
+            writer.array(std::vector<uint32_t>{});
+        }
+        writer.value<uint32_t>(12);
+        writer.array(std::vector<VertexElement>{{VertexAttribute::position, 0}});
+        writer.array(std::vector<std::byte>(12));
+        cask::BlobReader reader(writer.bytes_);
+
+        THEN("reading it throws") {
+            REQUIRE_THROWS_WITH(MeshData::read_blob(reader), "vertex buffer size must equal vertex count * stride");
+        }
+    }
+
+    GIVEN("a texture blob whose mip level has the wrong size") {
+        cask::BlobWriter writer;
+        writer.value<uint32_t>(2);
+        writer.value<uint32_t>(2);
+        writer.value<uint32_t>(1);
+        writer.array(std::vector<uint8_t>(4, 0));
+        writer.value<uint64_t>(1);
+        writer.value<uint32_t>(2);
+        writer.value<uint32_t>(2);
+        writer.array(std::vector<uint8_t>(4, 0));
+        writer.value<uint8_t>(0);
+        writer.value(BlockFormat::bc1);
+        writer.value<uint64_t>(0);
+        cask::BlobReader reader(writer.bytes_);
+
+        THEN("reading it throws") {
+            REQUIRE_THROWS_WITH(TextureData::read_blob(reader), "texture level size does not match its mip level");
+        }
+    }
+}
+
+SCENARIO("a cached loader skips the wrapped loader for unchanged sources", "[resource_cache]") {
+    GIVEN("a cached text-to-texture loader over a source file") {
+        TempDirectory directory;
+        std::filesystem::path source = directory.path / "brick.txt";
+        write_file(source, "abc");
+
+        std::atomic<int> invocations{0};
+        cask::ResourceCache cache(directory.path / "cache");
+        auto loader = cask::cached_loader<TextureData>(cache, [&invocations](const nlohmann::json& spec) {
+            invocations++;
+            std::ifstream file(spec.at("path").get<std::string>());
+            std::vector<uint8_t> pixels((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            return TextureData(static_cast<uint32_t>(pixels.size()), 1, 1, pixels);
+        });
+        nlohmann::json spec = {{"loader", "text"}, {"path", source.string()}};
+
+        WHEN("the same spec is loaded twice") {
+            TextureData first = loader(spec);
+            TextureData second = loader(spec);
+
+            THEN("the second load comes from the cache") {
+                REQUIRE(invocations == 1);
+                REQUIRE(cache.misses_ == 1);
+                REQUIRE(cache.hits_ == 1);
+                REQUIRE(second == first);
+            }
+        }
+
+        WHEN("the source file changes between loads") {
+            loader(spec);
+            write_file(source, "abcdef");
+            TextureData reloaded = loader(spec);
+
+            THEN("the loader runs again") {
+                REQUIRE(invocations == 2);
+                REQUIRE(reloaded.width() == 6);
+            }
+        }
+
+        WHEN("a cache entry is corrupted") {
+            loader(spec);
+            auto entry = cache.blob_path(*cache.key(ResourceDescriptor<TextureData>::store, spec));
+            write_file(entry, "garbage");
+            TextureData reloaded = loader(spec);
+
+            THEN("it is treated as a miss") {
+                REQUIRE(invocations == 2);
+                REQUIRE(reloaded.width() == 3);
+            }
+        }
+
+        WHEN("a cache entry parses but breaks the texture's invariants") {
+            loader(spec);
+            auto entry = cache.blob_path(*cache.key(ResourceDescriptor<TextureData>::store, spec));
+            std::fstream file(entry, std::ios::in | std::ios::out | std::ios::binary);
+            uint32_t width = 2;
+            file.seekp(static_cast<std::streamoff>(cask::align_blob_offset(sizeof(cask::ResourceCacheHeader))));
+            file.write(reinterpret_cast<const char*>(&width), sizeof(width));
+            file.close();
+            TextureData reloaded = loader(spec);
+
+            THEN("it is treated as a miss") {
+                REQUIRE(invocations == 2);
+                REQUIRE(reloaded.width() == 3);
+            }
+        }
+
+        WHEN("the source file is missing") {
+            std::filesystem::remove(source);
+
+            THEN("no key is produced and the loader runs uncached") {
+                REQUIRE_FALSE(cache.key(ResourceDescriptor<TextureData>::store, spec).has_value());
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include <catch2/catch_all.hpp>
+#include <cask/ecs/entity_compactor.hpp>
+#include <cask/ecs/entity_table.hpp>
+#include <cask/resource/resource_components.hpp>
+
+namespace {
+
+struct PooledResource {
+    int value;
+};
+
+struct EntityDestroyed {
+    uint32_t entity;
+};
+
+}
+
+SCENARIO("resource components count references on insert and remove", "[resource_components]") {
+    GIVEN("a resource store and an empty handle component store") {
+        ResourceStore<PooledResource> resources;
+        auto wall = resources.store("wall_mesh", PooledResource{1});
+        auto floor = resources.store("floor_mesh", PooledResource{2});
+        ComponentStore<ResourceHandle<PooledResource>> components;
+
+        WHEN("two entities reference the same resource") {
+            cask::insert_resource(components, resources, 1, wall);
+            cask::insert_resource(components, resources, 2, wall);
+
+            THEN("the resource has two references") {
+                REQUIRE(resources.ref_count(wall) == 2);
+            }
+
+            AND_WHEN("one entity is removed") {
+                cask::remove_resource(components, resources, 1);
+
+                THEN("one reference remains") {
+                    REQUIRE(resources.ref_count(wall) == 1);
+                    REQUIRE_FALSE(components.has(1));
+                }
+            }
+
+            AND_WHEN("an entity switches to another resource") {
+                cask::insert_resource(components, resources, 2, floor);
+
+                THEN("the references move with it") {
+                    REQUIRE(resources.ref_count(wall) == 1);
+                    REQUIRE(resources.ref_count(floor) == 1);
+                    REQUIRE(components.get(2).value == floor.value);
+                }
+            }
+        }
+
+        WHEN("an entity without the component is removed") {
+            THEN("nothing happens") {
+                REQUIRE_NOTHROW(cask::remove_resource(components, resources, 9));
+            }
+        }
+    }
+}
+
+SCENARIO("the entity compactor releases resource references", "[resource_components]") {
+    GIVEN("a compactor bound to resource components") {
+        EntityTable table;
+        uint32_t entity = table.create();
+
+        ResourceStore<PooledResource> resources;
+        auto wall = resources.store("wall_mesh", PooledResource{1});
+        ComponentStore<ResourceHandle<PooledResource>> components;
+        cask::insert_resource(components, resources, entity, wall);
+
+        cask::ResourceComponents<PooledResource> bound{&components, &resources};
+        EntityCompactor compactor{&table, {}};
+        compactor.add(&bound, cask::remove_resource_component<PooledResource>);
+
+        WHEN("the entity is destroyed") {
+            EventQueue<EntityDestroyed> queue;
+            queue.emit(EntityDestroyed{entity});
+            queue.swap();
+            compactor.compact(queue);
+
+            THEN("the resource is unreferenced") {
+                REQUIRE(resources.ref_count(wall) == 0);
+                REQUIRE_FALSE(components.has(entity));
+            }
+        }
+    }
+}
+
+SCENARIO("a source reloader reloads evicted resources from their loader spec", "[resource_components]") {
+    GIVEN("resource sources, loaders, and a store that evicts everything unreferenced") {
+        ResourceSources<PooledResource> sources;
+        sources.entries["wall_mesh"] = {{"loader", "inline"}, {"value", 7}};
+
+        cask::ResourceLoaderRegistry<PooledResource> loaders;
+        loaders.add("inline", [](const nlohmann::json& spec) {
+            return PooledResource{spec.at("value").get<int>()};
+        });
+
+        ResourceStore<PooledResource> resources;
+        resources.reloader_ = cask::source_reloader(sources, loaders);
+        auto wall = resources.store("wall_mesh", PooledResource{7});
+        resources.set_budget(0);
+
+        WHEN("the evicted handle is read") {
+            REQUIRE_FALSE(resources.resident(wall));
+            int value = resources.get(wall).value;
+
+            THEN("the loader spec restores the data") {
+                REQUIRE(value == 7);
+            }
+        }
+    }
+}
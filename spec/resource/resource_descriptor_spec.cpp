@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 #include <cask/resource/resource_descriptor.hpp>
+#include <cask/resource/mesh_lod_descriptor.hpp>
 #include <cask/resource/mesh_data.hpp>
 #include <cask/resource/texture_data.hpp>
 #include <cstring>
@@ -43,3 +44,11 @@ SCENARIO("TextureData descriptor provides correct component names", "[resource_d
         }
     }
 }
+
+SCENARIO("MeshLodChain descriptor lives beside the lod chain", "[resource_descriptor]") {
+    GIVEN("the ResourceDescriptor for MeshLodChain") {
+        THEN("store equals MeshLodStore") {
+            REQUIRE(std::strcmp(ResourceDescriptor<MeshLodChain>::store, "MeshLodStore") == 0);
+        }
+    }
+}
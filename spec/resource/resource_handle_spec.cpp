@@ -18,6 +18,16 @@ SCENARIO("a resource handle wraps a uint32_t value", "[resource_handle]") {
     }
 }
 
+SCENARIO("a resource handle starts at generation zero", "[resource_handle]") {
+    GIVEN("a handle constructed from only a value") {
+        ResourceHandle<MeshTag> handle{7};
+
+        THEN("its generation is zero") {
+            REQUIRE(handle.generation == 0);
+        }
+    }
+}
+
 SCENARIO("handles with different tags are distinct types", "[resource_handle]") {
     GIVEN("two handles with different tags and different values") {
         ResourceHandle<MeshTag> mesh_handle{1};
@@ -34,3 +44,10 @@ SCENARIO("handles with different tags are distinct types", "[resource_handle]")
         }
     }
 }
+
+SCENARIO("resource handles are recognised by type", "[resource_handle]") {
+    THEN("only ResourceHandle specialisations are resource handles") {
+        STATIC_REQUIRE(is_resource_handle_v<ResourceHandle<MeshTag>>);
+        STATIC_REQUIRE_FALSE(is_resource_handle_v<uint32_t>);
+    }
+}
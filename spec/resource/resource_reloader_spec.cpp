@@ -0,0 +1,223 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/resource_reloader.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct ReloadedResource {
+    std::string contents;
+
+    uint64_t content_hash() const {
+        return std::hash<std::string>{}(contents);
+    }
+
+    bool operator==(const ReloadedResource&) const = default;
+};
+
+cask::ResourceLoaderRegistry<ReloadedResource> file_loaders() {
+    cask::ResourceLoaderRegistry<ReloadedResource> loaders;
+    loaders.add("text", [](const nlohmann::json& spec) {
+        std::ifstream file(spec.at("path").get<std::string>());
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (contents == "broken") {
+            throw std::runtime_error("parse error");
+        }
+        return ReloadedResource{contents};
+    });
+    return loaders;
+}
+
+void write_file(const std::filesystem::path& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::trunc);
+    file << contents;
+}
+
+struct TempDirectory {
+    std::filesystem::path path;
+
+    TempDirectory() : path(std::filesystem::temp_directory_path() / ("cask_reloader_" + std::to_string(std::rand()))) {
+        std::filesystem::create_directories(path);
+    }
+
+    ~TempDirectory() {
+        std::filesystem::remove_all(path);
+    }
+};
+
+}
+
+SCENARIO("a changed source file is reloaded into the same handle at commit", "[resource_reloader]") {
+    GIVEN("a stored resource whose source file is watched") {
+        TempDirectory directory;
+        std::string path = (directory.path / "teapot.txt").string();
+        write_file(path, "first");
+
+        auto loaders = file_loaders();
+        ResourceStore<ReloadedResource> store;
+        cask::WorkerPool pool(0);
+        cask::ResourceReloader<ReloadedResource> reloader(store, loaders, pool);
+
+        ResourceSources<ReloadedResource> sources;
+        sources.entries["teapot"] = {{"loader", "text"}, {"path", path}};
+        auto handle = store.store("teapot", loaders.get("text")(sources.entries["teapot"]));
+        reloader.watch(sources);
+
+        THEN("nothing is scheduled while the file is unchanged") {
+            REQUIRE(reloader.poll() == 0);
+        }
+
+        WHEN("the file is rewritten") {
+            write_file(path, "second");
+            size_t scheduled = reloader.poll();
+            reloader.wait();
+
+            THEN("the old payload stays bound until the tick commits") {
+                REQUIRE(scheduled == 1);
+                REQUIRE(store.get(handle).contents == "first");
+            }
+
+            AND_WHEN("the tick commits") {
+                size_t swapped = reloader.commit();
+
+                THEN("the same handle resolves to the new payload") {
+                    REQUIRE(swapped == 1);
+                    REQUIRE(store.get(handle).contents == "second");
+                    REQUIRE(reloader.pending() == 0);
+                }
+            }
+        }
+
+        WHEN("the file is replaced by renaming a new file over it") {
+            std::string staged = (directory.path / "teapot.txt.tmp").string();
+            write_file(staged, "renamed");
+            std::filesystem::rename(staged, path);
+            reloader.poll();
+            reloader.wait();
+            reloader.commit();
+
+            THEN("the change is still picked up") {
+                REQUIRE(store.get(handle).contents == "renamed");
+            }
+        }
+
+        WHEN("the file changes twice before a commit") {
+            write_file(path, "second");
+            reloader.poll();
+            write_file(path, "third");
+            reloader.poll();
+            reloader.wait();
+
+            THEN("only the latest load is swapped in") {
+                REQUIRE(reloader.commit() == 1);
+                REQUIRE(store.get(handle).contents == "third");
+            }
+        }
+
+        WHEN("the new contents fail to load") {
+            write_file(path, "broken");
+            reloader.poll();
+            reloader.wait();
+
+            THEN("commit reports the key and the old payload is kept") {
+                REQUIRE_THROWS_WITH(reloader.commit(), Catch::Matchers::ContainsSubstring("teapot"));
+                REQUIRE(store.get(handle).contents == "first");
+            }
+        }
+    }
+}
+
+SCENARIO("reloading one file leaves resources deduplicated with it unchanged", "[resource_reloader]") {
+    GIVEN("two watched files with identical contents in a deduplicating store") {
+        TempDirectory directory;
+        std::string teapot_path = (directory.path / "teapot.txt").string();
+        std::string kettle_path = (directory.path / "kettle.txt").string();
+        write_file(teapot_path, "same");
+        write_file(kettle_path, "same");
+
+        auto loaders = file_loaders();
+        ResourceStore<ReloadedResource> store;
+        store.deduplicate_ = true;
+        cask::WorkerPool pool(0);
+        cask::ResourceReloader<ReloadedResource> reloader(store, loaders, pool);
+
+        ResourceSources<ReloadedResource> sources;
+        sources.entries["teapot"] = {{"loader", "text"}, {"path", teapot_path}};
+        sources.entries["kettle"] = {{"loader", "text"}, {"path", kettle_path}};
+        auto teapot = store.store("teapot", loaders.get("text")(sources.entries["teapot"]));
+        auto kettle = store.store("kettle", loaders.get("text")(sources.entries["kettle"]));
+        reloader.watch(sources);
+
+        WHEN("only one of the files changes") {
+            write_file(teapot_path, "edited");
+            reloader.poll();
+            reloader.wait();
+            reloader.commit();
+
+            THEN("only its key sees the new contents") {
+                REQUIRE(store.dedup_hits_ == 1);
+                REQUIRE(store.get(teapot).contents == "edited");
+                REQUIRE(store.get(kettle).contents == "same");
+            }
+        }
+    }
+}
+
+SCENARIO("a failed reload reports every failed key", "[resource_reloader]") {
+    GIVEN("two watched files") {
+        TempDirectory directory;
+        std::string teapot_path = (directory.path / "teapot.txt").string();
+        std::string kettle_path = (directory.path / "kettle.txt").string();
+        write_file(teapot_path, "teapot");
+        write_file(kettle_path, "kettle");
+
+        auto loaders = file_loaders();
+        ResourceStore<ReloadedResource> store;
+        cask::WorkerPool pool(0);
+        cask::ResourceReloader<ReloadedResource> reloader(store, loaders, pool);
+
+        ResourceSources<ReloadedResource> sources;
+        sources.entries["teapot"] = {{"loader", "text"}, {"path", teapot_path}};
+        sources.entries["kettle"] = {{"loader", "text"}, {"path", kettle_path}};
+        store.store("teapot", loaders.get("text")(sources.entries["teapot"]));
+        store.store("kettle", loaders.get("text")(sources.entries["kettle"]));
+        reloader.watch(sources);
+
+        WHEN("both files are broken") {
+            write_file(teapot_path, "broken");
+            write_file(kettle_path, "broken");
+            reloader.poll();
+            reloader.wait();
+
+            THEN("commit names both keys") {
+                REQUIRE_THROWS_WITH(
+                    reloader.commit(),
+                    Catch::Matchers::ContainsSubstring("teapot") && Catch::Matchers::ContainsSubstring("kettle")
+                );
+            }
+        }
+    }
+}
+
+SCENARIO("loader specs without a path are not watched", "[resource_reloader]") {
+    GIVEN("an inline resource") {
+        auto loaders = file_loaders();
+        ResourceStore<ReloadedResource> store;
+        cask::WorkerPool pool(0);
+        cask::ResourceReloader<ReloadedResource> reloader(store, loaders, pool);
+
+        WHEN("it is watched") {
+            reloader.watch("inline", {{"loader", "text"}, {"value", 3}});
+
+            THEN("no file is registered") {
+                REQUIRE(reloader.watched_.empty());
+                REQUIRE(reloader.poll() == 0);
+            }
+        }
+    }
+}
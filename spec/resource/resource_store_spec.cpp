@@ -1,6 +1,9 @@
 #include <catch2/catch_all.hpp>
+#include <cask/resource/mesh_data.hpp>
 #include <cask/resource/resource_handle.hpp>
 #include <cask/resource/resource_store.hpp>
+#include <cask/resource/texture_data.hpp>
+#include <limits>
 
 struct TestResource {
     int value;
@@ -40,3 +43,370 @@ SCENARIO("storing the same key twice returns the same handle", "[resource_store]
         }
     }
 }
+
+SCENARIO("replace swaps the data behind an existing handle", "[resource_store]") {
+    GIVEN("a resource store with a stored resource") {
+        ResourceStore<TestResource> store;
+        auto handle = store.store("swapped_asset", TestResource{1});
+
+        WHEN("the resource is replaced") {
+            store.replace(handle, TestResource{2});
+
+            THEN("the handle resolves to the new data under the same key") {
+                REQUIRE(store.get(handle).value == 2);
+                REQUIRE(store.key(handle) == "swapped_asset");
+            }
+        }
+    }
+}
+
+SCENARIO("acquire and release track references per handle", "[resource_store]") {
+    GIVEN("a resource store with a stored resource") {
+        ResourceStore<TestResource> store;
+        auto handle = store.store("counted_asset", TestResource{5});
+
+        WHEN("the handle is acquired twice and released once") {
+            store.acquire(handle);
+            store.acquire(handle);
+            store.release(handle);
+
+            THEN("one reference remains") {
+                REQUIRE(store.ref_count(handle) == 1);
+            }
+        }
+
+        WHEN("an unreferenced handle is released") {
+            THEN("it throws") {
+                REQUIRE_THROWS(store.release(handle));
+            }
+        }
+    }
+}
+
+SCENARIO("a budget evicts the least recently used unreferenced resource", "[resource_store]") {
+    GIVEN("a store with three resources and room for two") {
+        ResourceStore<TestResource> store;
+        store.set_budget(2 * sizeof(TestResource));
+
+        auto first = store.store("first", TestResource{1});
+        auto second = store.store("second", TestResource{2});
+
+        WHEN("the first is used again before a third is stored") {
+            store.get(first);
+            auto third = store.store("third", TestResource{3});
+
+            THEN("the second, least recently used, is evicted") {
+                REQUIRE(store.resident(first));
+                REQUIRE_FALSE(store.resident(second));
+                REQUIRE(store.resident(third));
+                REQUIRE(store.evictions_ == 1);
+                REQUIRE(store.resident_bytes_ == 2 * sizeof(TestResource));
+            }
+        }
+
+        WHEN("the first and second are referenced before a third is stored") {
+            store.acquire(first);
+            store.acquire(second);
+            auto third = store.store("third", TestResource{3});
+
+            THEN("nothing referenced is evicted and the store runs over budget") {
+                REQUIRE(store.resident(first));
+                REQUIRE(store.resident(second));
+                REQUIRE(store.resident(third));
+            }
+
+            AND_WHEN("the second is released") {
+                store.release(second);
+
+                THEN("the older unreferenced third is evicted to return under budget") {
+                    REQUIRE_FALSE(store.resident(third));
+                    REQUIRE(store.resident(second));
+                    REQUIRE(store.resident_bytes_ == 2 * sizeof(TestResource));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("an evicted resource reloads through the reloader on next use", "[resource_store]") {
+    GIVEN("a store with a reloader and a budget for one resource") {
+        ResourceStore<TestResource> store;
+        std::vector<std::string> reloaded;
+        store.reloader_ = [&reloaded](const std::string& key) {
+            reloaded.push_back(key);
+            return TestResource{key == "first" ? 10 : 20};
+        };
+        store.set_budget(sizeof(TestResource));
+
+        auto first = store.store("first", TestResource{1});
+        auto second = store.store("second", TestResource{2});
+
+        WHEN("the evicted handle is read") {
+            auto& resource = store.get(first);
+
+            THEN("it is reloaded by key under the same handle") {
+                REQUIRE(resource.value == 10);
+                REQUIRE(reloaded == std::vector<std::string>{"first"});
+                REQUIRE(store.resident(first));
+            }
+
+            THEN("nothing is evicted until the store is trimmed") {
+                REQUIRE(store.resident(second));
+
+                store.trim();
+                REQUIRE(store.resident(first));
+                REQUIRE_FALSE(store.resident(second));
+                REQUIRE(store.resident_bytes_ == sizeof(TestResource));
+            }
+        }
+
+        WHEN("the evicted handle and another handle are read back to back") {
+            auto& first_resource = store.get(first);
+            auto& second_resource = store.get(second);
+
+            THEN("the first reference is still valid after the second read") {
+                REQUIRE(store.resident(first));
+                REQUIRE(store.resident(second));
+                REQUIRE(first_resource.value == 10);
+                REQUIRE(second_resource.value == 2);
+            }
+        }
+    }
+
+    GIVEN("a store without a reloader") {
+        ResourceStore<TestResource> store;
+        auto handle = store.store("only", TestResource{1});
+        store.set_budget(0);
+
+        THEN("reading the evicted handle throws") {
+            REQUIRE_FALSE(store.resident(handle));
+            REQUIRE_THROWS(store.get(handle));
+        }
+    }
+}
+
+SCENARIO("resource byte sizes use byte_size when a resource provides one", "[resource_store]") {
+    struct SizedResource {
+        size_t bytes;
+        size_t byte_size() const { return bytes; }
+    };
+
+    THEN("sized resources report their payload") {
+        REQUIRE(resource_bytes(SizedResource{4096}) == 4096);
+    }
+
+    THEN("other resources fall back to their object size") {
+        REQUIRE(resource_bytes(TestResource{0}) == sizeof(TestResource));
+    }
+}
+
+SCENARIO("content deduplication shares one payload between identical resources", "[resource_store]") {
+    GIVEN("a deduplicating mesh store") {
+        ResourceStore<MeshData> store;
+        store.deduplicate_ = true;
+
+        MeshData triangle({0, 0, 0, 1, 0, 0, 0, 1, 0}, {0, 1, 2});
+
+        WHEN("the same mesh is stored under two keys") {
+            auto first = store.store("crate_a", triangle);
+            auto second = store.store("crate_b", triangle);
+
+            THEN("each key keeps its own handle over one shared payload") {
+                REQUIRE(first.value != second.value);
+                REQUIRE(&store.get(first) == &store.get(second));
+                REQUIRE(store.key(second) == "crate_b");
+                REQUIRE(store.key_to_handle_.at("crate_b") == second.value);
+            }
+
+            THEN("the stats report the saved bytes") {
+                REQUIRE(store.dedup_hits_ == 1);
+                REQUIRE(store.dedup_bytes_saved_ == triangle.byte_size());
+                REQUIRE(store.resident_bytes_ == triangle.byte_size());
+            }
+        }
+
+        WHEN("a different mesh is stored") {
+            auto first = store.store("crate", triangle);
+            auto second = store.store("ramp", MeshData({0, 0, 0, 1, 0, 0, 0, 0, 1}, {0, 1, 2}));
+
+            THEN("it gets its own payload") {
+                REQUIRE(&store.get(first) != &store.get(second));
+                REQUIRE(store.dedup_hits_ == 0);
+            }
+        }
+    }
+
+    GIVEN("a store without deduplication") {
+        ResourceStore<TextureData> store;
+        TextureData pixel(1, 1, 4, {1, 2, 3, 4});
+
+        WHEN("the same texture is stored under two keys") {
+            auto first = store.store("a", pixel);
+            auto second = store.store("b", pixel);
+
+            THEN("each key keeps its own slot") {
+                REQUIRE(first.value != second.value);
+            }
+        }
+    }
+}
+
+SCENARIO("replacing deduplicated content reindexes the slot", "[resource_store]") {
+    GIVEN("a deduplicating texture store with one texture") {
+        ResourceStore<TextureData> store;
+        store.deduplicate_ = true;
+        auto handle = store.store("grass", TextureData(1, 1, 1, {10}));
+
+        WHEN("the slot is replaced with new pixels") {
+            store.replace(handle, TextureData(1, 1, 1, {20}));
+
+            THEN("the old content no longer dedupes to the slot") {
+                auto other = store.store("dirt", TextureData(1, 1, 1, {10}));
+                REQUIRE(&store.get(other) != &store.get(handle));
+            }
+
+            THEN("the new content does") {
+                auto other = store.store("moss", TextureData(1, 1, 1, {20}));
+                REQUIRE(&store.get(other) == &store.get(handle));
+            }
+        }
+    }
+}
+
+SCENARIO("replacing one deduplicated key leaves the keys that shared its payload untouched", "[resource_store]") {
+    GIVEN("a deduplicating texture store with three keys on one payload") {
+        ResourceStore<TextureData> store;
+        store.deduplicate_ = true;
+        auto grass = store.store("grass", TextureData(1, 1, 1, {10}));
+        auto lawn = store.store("lawn", TextureData(1, 1, 1, {10}));
+        auto field = store.store("field", TextureData(1, 1, 1, {10}));
+
+        WHEN("an alias is replaced") {
+            store.replace(lawn, TextureData(1, 1, 1, {20}));
+
+            THEN("only that key sees the new content") {
+                REQUIRE(store.get(lawn).pixels()[0] == 20);
+                REQUIRE(store.get(grass).pixels()[0] == 10);
+                REQUIRE(store.get(field).pixels()[0] == 10);
+                REQUIRE(&store.get(grass) == &store.get(field));
+            }
+
+            THEN("an evicted alias reloads through its own key") {
+                std::vector<std::string> reloaded;
+                store.reloader_ = [&reloaded](const std::string& key) {
+                    reloaded.push_back(key);
+                    return TextureData(1, 1, 1, {static_cast<uint8_t>(key == "lawn" ? 20 : 10)});
+                };
+                store.set_budget(0);
+
+                REQUIRE(store.get(lawn).pixels()[0] == 20);
+                REQUIRE(reloaded == std::vector<std::string>{"lawn"});
+            }
+        }
+
+        WHEN("the key that first stored the payload is replaced") {
+            store.acquire(lawn);
+            store.replace(grass, TextureData(1, 1, 1, {30}));
+
+            THEN("the other keys keep the old content and their references") {
+                REQUIRE(store.get(grass).pixels()[0] == 30);
+                REQUIRE(store.get(lawn).pixels()[0] == 10);
+                REQUIRE(&store.get(lawn) == &store.get(field));
+                REQUIRE(store.resident_bytes_ == 2 * store.get(grass).byte_size());
+            }
+
+            THEN("the old content still dedupes to the keys that kept it") {
+                auto meadow = store.store("meadow", TextureData(1, 1, 1, {10}));
+                REQUIRE(&store.get(meadow) == &store.get(lawn));
+            }
+
+            THEN("the referenced payload stays pinned under a zero budget") {
+                store.set_budget(0);
+                REQUIRE(store.resident(lawn));
+                REQUIRE(store.resident(field));
+                REQUIRE_FALSE(store.resident(grass));
+            }
+        }
+    }
+}
+
+SCENARIO("deduplication never aliases an evicted payload", "[resource_store]") {
+    GIVEN("a deduplicating texture store whose only payload was evicted") {
+        ResourceStore<TextureData> store;
+        store.deduplicate_ = true;
+        auto grass = store.store("grass", TextureData(1, 1, 1, {10}));
+        store.set_budget(0);
+        store.set_budget(std::numeric_limits<size_t>::max());
+
+        WHEN("content with the same hash is stored under a new key") {
+            auto lawn = store.store("lawn", TextureData(1, 1, 1, {10}));
+
+            THEN("it gets its own payload instead of aliasing the evicted one") {
+                REQUIRE(store.dedup_hits_ == 0);
+                REQUIRE(store.resident(lawn));
+                REQUIRE_FALSE(store.resident(grass));
+            }
+        }
+    }
+}
+
+SCENARIO("removing a resource frees its slot for reuse under a new generation", "[resource_store]") {
+    GIVEN("a store with two resources") {
+        ResourceStore<TestResource> store;
+        auto first = store.store("old_asset", TestResource{1});
+        auto second = store.store("kept_asset", TestResource{2});
+
+        WHEN("the first is removed and a new key is stored") {
+            store.remove(first);
+            auto reused = store.store("new_asset", TestResource{3});
+
+            THEN("the freed slot is reused with a bumped generation") {
+                REQUIRE(reused.value == first.value);
+                REQUIRE(reused.generation == first.generation + 1);
+                REQUIRE(store.size() == 2);
+                REQUIRE(store.get(reused).value == 3);
+                REQUIRE(store.key(reused) == "new_asset");
+            }
+
+            THEN("the removed key is no longer found") {
+                REQUIRE_FALSE(store.find("old_asset").has_value());
+                REQUIRE(store.find("kept_asset")->value == second.value);
+            }
+
+            THEN("the stale handle is rejected") {
+                REQUIRE_FALSE(store.valid(first));
+                REQUIRE_THROWS_WITH(store.get(first), Catch::Matchers::ContainsSubstring("stale"));
+            }
+        }
+
+        WHEN("a referenced resource is removed") {
+            store.acquire(second);
+
+            THEN("it throws") {
+                REQUIRE_THROWS(store.remove(second));
+            }
+        }
+    }
+}
+
+SCENARIO("removing a deduplicated key hands its payload to the keys that shared it", "[resource_store]") {
+    GIVEN("a deduplicating texture store with two keys on one payload and an unrelated key") {
+        ResourceStore<TextureData> store;
+        store.deduplicate_ = true;
+        auto shared = store.store("grass", TextureData(1, 1, 1, {10}));
+        store.store("lawn", TextureData(1, 1, 1, {10}));
+        auto other = store.store("dirt", TextureData(1, 1, 1, {30}));
+
+        WHEN("the shared resource is removed") {
+            store.remove(store.find("grass").value());
+
+            THEN("only its own key is gone and the alias keeps the payload") {
+                REQUIRE_FALSE(store.find("grass").has_value());
+                REQUIRE(store.get(store.find("lawn").value()).pixels()[0] == 10);
+                REQUIRE(store.find("dirt")->value == other.value);
+                REQUIRE(store.key_to_handle_.size() == 2);
+                REQUIRE_FALSE(store.valid(shared));
+            }
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/mesh_data.hpp>
+#include <cask/resource/resource_streamer.hpp>
+#include <cask/resource/texture_data.hpp>
+#include <atomic>
+#include <stdexcept>
+
+namespace {
+
+struct StreamedResource {
+    int value;
+};
+
+cask::ResourceLoaderRegistry<StreamedResource> counting_loaders(std::atomic<int>& invocations) {
+    cask::ResourceLoaderRegistry<StreamedResource> loaders;
+    loaders.add("inline", [&invocations](const nlohmann::json& spec) {
+        invocations++;
+        return StreamedResource{spec.at("value").get<int>()};
+    });
+    loaders.add("broken", [](const nlohmann::json&) -> StreamedResource {
+        throw std::runtime_error("file not found");
+    });
+    return loaders;
+}
+
+}
+
+SCENARIO("a streamed resource is bound to the placeholder until committed", "[resource_streamer]") {
+    GIVEN("a streamer over a pool without threads") {
+        std::atomic<int> invocations{0};
+        auto loaders = counting_loaders(invocations);
+        ResourceStore<StreamedResource> store;
+        cask::WorkerPool pool(0);
+        cask::ResourceStreamer<StreamedResource> streamer(store, loaders, pool, StreamedResource{-1});
+
+        WHEN("a resource is requested") {
+            auto handle = streamer.request("wall_mesh", {{"loader", "inline"}, {"value", 42}});
+
+            THEN("the handle resolves to the placeholder right away") {
+                REQUIRE(store.get(handle).value == -1);
+                REQUIRE(store.key(handle) == "wall_mesh");
+                REQUIRE(streamer.pending() == 1);
+            }
+
+            AND_WHEN("the load finishes but no tick has passed") {
+                streamer.wait();
+
+                THEN("the placeholder is still bound") {
+                    REQUIRE(invocations == 1);
+                    REQUIRE(store.get(handle).value == -1);
+                    REQUIRE(streamer.pending() == 1);
+                }
+            }
+
+            AND_WHEN("the load finishes and the tick commits it") {
+                streamer.wait();
+                size_t committed = streamer.commit();
+
+                THEN("the same handle resolves to the loaded data") {
+                    REQUIRE(committed == 1);
+                    REQUIRE(store.get(handle).value == 42);
+                    REQUIRE(streamer.pending() == 0);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("requesting a streamed key twice loads it once", "[resource_streamer]") {
+    GIVEN("a streamer with worker threads") {
+        std::atomic<int> invocations{0};
+        auto loaders = counting_loaders(invocations);
+        ResourceStore<StreamedResource> store;
+        cask::WorkerPool pool(2);
+        cask::ResourceStreamer<StreamedResource> streamer(store, loaders, pool, StreamedResource{-1});
+
+        WHEN("the same key is requested twice") {
+            auto first = streamer.request("floor_mesh", {{"loader", "inline"}, {"value", 7}});
+            auto second = streamer.request("floor_mesh", {{"loader", "inline"}, {"value", 8}});
+            streamer.wait();
+            streamer.commit();
+
+            THEN("both handles match and the loader ran once") {
+                REQUIRE(first.value == second.value);
+                REQUIRE(invocations == 1);
+                REQUIRE(store.get(first).value == 7);
+            }
+        }
+    }
+}
+
+SCENARIO("a failed stream keeps the placeholder and reports at commit", "[resource_streamer]") {
+    GIVEN("a streamer and a request whose loader throws") {
+        std::atomic<int> invocations{0};
+        auto loaders = counting_loaders(invocations);
+        ResourceStore<StreamedResource> store;
+        cask::WorkerPool pool(1);
+        cask::ResourceStreamer<StreamedResource> streamer(store, loaders, pool, StreamedResource{-1});
+
+        auto broken = streamer.request("missing_mesh", {{"loader", "broken"}});
+        auto also_broken = streamer.request("missing_texture", {{"loader", "broken"}});
+        auto working = streamer.request("wall_mesh", {{"loader", "inline"}, {"value", 3}});
+        streamer.wait();
+
+        THEN("commit throws naming every failed key and still swaps in the successful load") {
+            REQUIRE_THROWS_WITH(
+                streamer.commit(),
+                Catch::Matchers::ContainsSubstring("missing_mesh") &&
+                Catch::Matchers::ContainsSubstring("missing_texture") &&
+                Catch::Matchers::ContainsSubstring("file not found")
+            );
+            REQUIRE(store.get(broken).value == -1);
+            REQUIRE(store.get(also_broken).value == -1);
+            REQUIRE(store.get(working).value == 3);
+            REQUIRE(streamer.failed("missing_mesh"));
+            REQUIRE_FALSE(streamer.failed("wall_mesh"));
+        }
+
+        WHEN("the failed key is requested again after the commit") {
+            REQUIRE_THROWS(streamer.commit());
+            auto retried = streamer.request("missing_mesh", {{"loader", "inline"}, {"value", 9}});
+            streamer.wait();
+            streamer.commit();
+
+            THEN("the load is retried into the same handle") {
+                REQUIRE(retried.value == broken.value);
+                REQUIRE(store.get(broken).value == 9);
+                REQUIRE_FALSE(streamer.failed("missing_mesh"));
+                REQUIRE(invocations == 2);
+            }
+        }
+    }
+
+    GIVEN("a request naming an unknown loader") {
+        std::atomic<int> invocations{0};
+        auto loaders = counting_loaders(invocations);
+        ResourceStore<StreamedResource> store;
+        cask::WorkerPool pool(0);
+        cask::ResourceStreamer<StreamedResource> streamer(store, loaders, pool, StreamedResource{-1});
+
+        THEN("request throws before binding a handle") {
+            REQUIRE_THROWS(streamer.request("wall_mesh", {{"loader", "unknown"}}));
+            REQUIRE(store.size() == 0);
+        }
+    }
+}
+
+SCENARIO("default placeholders are valid resources", "[resource_streamer]") {
+    GIVEN("the default mesh and texture placeholders") {
+        auto mesh = placeholder_mesh();
+        auto texture = placeholder_texture();
+
+        THEN("the mesh is a single degenerate triangle") {
+            REQUIRE(mesh.positions().size() == 3);
+            REQUIRE(mesh.indices().size() == 3);
+        }
+
+        THEN("the texture is a single RGBA pixel") {
+            REQUIRE(texture.width() == 1);
+            REQUIRE(texture.height() == 1);
+            REQUIRE(texture.pixels().size() == 4);
+        }
+    }
+}
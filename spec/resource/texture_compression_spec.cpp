@@ -0,0 +1,112 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/texture_compression.hpp>
+
+SCENARIO("bc1 blocks encode solid and two-tone colors", "[texture_compression]") {
+    GIVEN("a block of one 565-exact color") {
+        std::vector<uint8_t> pixels;
+        for (int texel = 0; texel < 16; ++texel) {
+            pixels.insert(pixels.end(), {255, 0, 255});
+        }
+
+        WHEN("it is compressed and decompressed") {
+            auto compressed = compress_blocks(BlockFormat::bc1, 4, 4, 3, pixels);
+            auto decoded = decompress_blocks(BlockFormat::bc1, 4, 4, compressed);
+
+            THEN("the block is eight bytes") {
+                REQUIRE(compressed.size() == 8);
+            }
+
+            THEN("every texel decodes exactly with opaque alpha") {
+                for (int texel = 0; texel < 16; ++texel) {
+                    REQUIRE(decoded[texel * 4] == 255);
+                    REQUIRE(decoded[texel * 4 + 1] == 0);
+                    REQUIRE(decoded[texel * 4 + 2] == 255);
+                    REQUIRE(decoded[texel * 4 + 3] == 255);
+                }
+            }
+        }
+    }
+
+    GIVEN("a block split between black and white") {
+        std::vector<uint8_t> pixels;
+        for (int texel = 0; texel < 16; ++texel) {
+            pixels.push_back(texel % 2 == 0 ? 0 : 255);
+        }
+
+        WHEN("it is round tripped") {
+            auto decoded = decompress_blocks(BlockFormat::bc1, 4, 4, compress_blocks(BlockFormat::bc1, 4, 4, 1, pixels));
+
+            THEN("both endpoints are reproduced") {
+                for (int texel = 0; texel < 16; ++texel) {
+                    REQUIRE(decoded[texel * 4] == pixels[texel]);
+                    REQUIRE(decoded[texel * 4 + 2] == pixels[texel]);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("bc3 blocks keep an alpha channel", "[texture_compression]") {
+    GIVEN("a block with two alpha values") {
+        std::vector<uint8_t> pixels;
+        for (int texel = 0; texel < 16; ++texel) {
+            pixels.insert(pixels.end(), {40, 80, 120, static_cast<uint8_t>(texel < 8 ? 0 : 200)});
+        }
+
+        WHEN("it is round tripped") {
+            auto compressed = compress_blocks(BlockFormat::bc3, 4, 4, 4, pixels);
+            auto decoded = decompress_blocks(BlockFormat::bc3, 4, 4, compressed);
+
+            THEN("the block is sixteen bytes") {
+                REQUIRE(compressed.size() == 16);
+            }
+
+            THEN("alpha is exact") {
+                for (int texel = 0; texel < 16; ++texel) {
+                    REQUIRE(decoded[texel * 4 + 3] == pixels[texel * 4 + 3]);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("bc3 color blocks always interpolate four colors", "[texture_compression]") {
+    GIVEN("a hand-built bc3 block whose first color endpoint is below the second") {
+        std::vector<uint8_t> compressed{
+            255, 255, 0, 0, 0, 0, 0, 0,
+            0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+        };
+
+        WHEN("it is decoded") {
+            auto decoded = decompress_blocks(BlockFormat::bc3, 4, 4, compressed);
+
+            THEN("every texel takes the two-thirds interpolant rather than bc1 black") {
+                for (int texel = 0; texel < 16; ++texel) {
+                    REQUIRE(decoded[texel * 4] == 170);
+                    REQUIRE(decoded[texel * 4 + 1] == 170);
+                    REQUIRE(decoded[texel * 4 + 2] == 170);
+                    REQUIRE(decoded[texel * 4 + 3] == 255);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("textures that are not a multiple of four use partial blocks", "[texture_compression]") {
+    GIVEN("a 5x3 texture") {
+        std::vector<uint8_t> pixels(5 * 3, 90);
+
+        WHEN("it is compressed") {
+            auto compressed = compress_blocks(BlockFormat::bc1, 5, 3, 1, pixels);
+
+            THEN("the edge blocks are padded") {
+                REQUIRE(compressed.size() == compressed_size(BlockFormat::bc1, 5, 3));
+                REQUIRE(compressed.size() == 2 * 8);
+            }
+
+            THEN("decoding rejects mismatched sizes") {
+                REQUIRE_THROWS(decompress_blocks(BlockFormat::bc1, 8, 8, compressed));
+            }
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 #include <cask/resource/texture_data.hpp>
+#include <algorithm>
 
 SCENARIO("valid texture data can be constructed with dimensions channels and pixels", "[texture_data]") {
     GIVEN("a 2x2 RGBA texture with 16 bytes of pixel data") {
@@ -101,3 +102,132 @@ SCENARIO("construction throws when pixel data size does not match dimensions", "
         }
     }
 }
+
+SCENARIO("texture data generates a box filtered mip chain", "[texture_data]") {
+    GIVEN("a 4x2 single channel texture") {
+        TextureData texture(4, 2, 1, {0, 4, 8, 12, 16, 20, 24, 28});
+
+        THEN("only the base level exists before generation") {
+            REQUIRE(texture.mip_count() == 1);
+            REQUIRE(texture.mip_pixels(0).data() == texture.pixels().data());
+        }
+
+        WHEN("mips are generated") {
+            texture.generate_mips();
+
+            THEN("levels halve down to 1x1") {
+                REQUIRE(texture.mip_count() == 3);
+                REQUIRE(texture.mip_width(1) == 2);
+                REQUIRE(texture.mip_height(1) == 1);
+                REQUIRE(texture.mip_width(2) == 1);
+                REQUIRE(texture.mip_height(2) == 1);
+            }
+
+            THEN("each texel averages its 2x2 footprint") {
+                REQUIRE(std::ranges::equal(texture.mip_pixels(1), std::vector<uint8_t>{10, 18}));
+                REQUIRE(std::ranges::equal(texture.mip_pixels(2), std::vector<uint8_t>{14}));
+            }
+
+            THEN("the levels count towards the byte size") {
+                REQUIRE(texture.byte_size() == 8 + 2 + 1);
+            }
+        }
+    }
+}
+
+SCENARIO("odd sized mip levels keep their last row and column", "[texture_data]") {
+    GIVEN("a 3x1 texture whose only bright texel is in the last column") {
+        TextureData texture(3, 1, 1, {0, 0, 90});
+
+        WHEN("mips are generated") {
+            texture.generate_mips();
+
+            THEN("the last column contributes to the next level") {
+                REQUIRE(std::ranges::equal(texture.mip_pixels(1), std::vector<uint8_t>{30}));
+            }
+        }
+    }
+
+    GIVEN("a 5x5 texture") {
+        std::vector<uint8_t> pixels(25, 0);
+        pixels[24] = 250;
+        TextureData texture(5, 5, 1, pixels);
+
+        WHEN("mips are generated") {
+            texture.generate_mips();
+
+            THEN("the corner texel is weighted into the nearest output texel only") {
+                REQUIRE(texture.mip_width(1) == 2);
+                REQUIRE(std::ranges::equal(texture.mip_pixels(1), std::vector<uint8_t>{0, 0, 0, 40}));
+            }
+        }
+    }
+}
+
+SCENARIO("texture data caches a block compressed form", "[texture_data]") {
+    GIVEN("an 8x8 RGBA texture with mips") {
+        std::vector<uint8_t> pixels;
+        for (uint32_t texel = 0; texel < 64; ++texel) {
+            pixels.insert(pixels.end(), {static_cast<uint8_t>(texel * 4), 128, 64, 255});
+        }
+        TextureData texture(8, 8, 4, pixels);
+        texture.generate_mips();
+
+        WHEN("it is compressed to bc1") {
+            texture.compress(BlockFormat::bc1);
+
+            THEN("every level has a compressed copy") {
+                REQUIRE(texture.is_compressed());
+                REQUIRE(texture.compressed_format() == BlockFormat::bc1);
+                REQUIRE(texture.compressed_level(0).size() == 4 * 8);
+                REQUIRE(texture.compressed_level(3).size() == 8);
+            }
+
+            AND_WHEN("the uncompressed pixels are dropped") {
+                size_t compressed_bytes = 32 + 8 + 8 + 8;
+                texture.drop_pixels();
+
+                THEN("only the compressed levels remain") {
+                    REQUIRE_FALSE(texture.has_pixels());
+                    REQUIRE(texture.mip_count() == 4);
+                    REQUIRE(texture.byte_size() == compressed_bytes);
+                    REQUIRE_THROWS(texture.mip_pixels(0));
+                }
+            }
+        }
+
+        WHEN("it is compressed to bc3") {
+            texture.compress(BlockFormat::bc3);
+
+            THEN("the base level decodes close to the source") {
+                auto decoded = decompress_blocks(BlockFormat::bc3, 8, 8, texture.compressed_level(0));
+                for (size_t index = 0; index < pixels.size(); ++index) {
+                    REQUIRE(std::abs(decoded[index] - pixels[index]) <= 16);
+                }
+            }
+        }
+    }
+
+    GIVEN("an uncompressed texture") {
+        TextureData texture(1, 1, 1, {10});
+
+        THEN("dropping its pixels throws") {
+            REQUIRE_THROWS_WITH(texture.drop_pixels(), Catch::Matchers::ContainsSubstring("compressed"));
+        }
+    }
+}
+
+SCENARIO("texture data adopts a pooled pixel buffer without copying it", "[texture_data]") {
+    GIVEN("pixels already in a payload vector") {
+        cask::PayloadVector<uint8_t> pixels(2 * 2 * 4, 255);
+        const uint8_t* buffer = pixels.data();
+
+        WHEN("they are moved into a texture") {
+            TextureData texture(2, 2, 4, std::move(pixels));
+
+            THEN("the texture keeps the same buffer") {
+                REQUIRE(texture.pixels().data() == buffer);
+            }
+        }
+    }
+}
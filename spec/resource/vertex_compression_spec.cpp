@@ -0,0 +1,98 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/vertex_compression.hpp>
+#include <cmath>
+#include <limits>
+
+SCENARIO("half floats round trip representable values", "[vertex_compression]") {
+    GIVEN("values exactly representable as halves") {
+        std::vector<float> values = {0.0f, 1.0f, -2.5f, 0.5f, 65504.0f, std::ldexp(1.0f, -24)};
+
+        THEN("decoding the encoding restores them") {
+            REQUIRE(decode_halves(encode_halves(values)) == values);
+        }
+
+        THEN("one encodes to its standard bit pattern") {
+            REQUIRE(float_to_half(1.0f) == 0x3C00);
+            REQUIRE(float_to_half(-2.0f) == 0xC000);
+        }
+    }
+
+    GIVEN("values outside the half range") {
+        THEN("they saturate to infinity") {
+            REQUIRE(float_to_half(1.0e6f) == 0x7C00);
+            REQUIRE(std::isinf(half_to_float(float_to_half(-1.0e6f))));
+        }
+
+        THEN("nan stays nan") {
+            REQUIRE(std::isnan(half_to_float(float_to_half(std::numeric_limits<float>::quiet_NaN()))));
+        }
+    }
+
+    GIVEN("a uv coordinate between half steps") {
+        float uv = 0.3337f;
+
+        THEN("the error stays within half a step") {
+            REQUIRE(std::abs(half_to_float(float_to_half(uv)) - uv) <= std::ldexp(1.0f, -13));
+        }
+    }
+}
+
+SCENARIO("octahedral normals decode close to the original direction", "[vertex_compression]") {
+    GIVEN("normals across both hemispheres") {
+        std::vector<float> normals = {
+            0, 0, 1,
+            0, 0, -1,
+            1, 0, 0,
+            0.267261f, -0.534522f, -0.801784f,
+            -0.57735f, 0.57735f, 0.57735f
+        };
+
+        WHEN("they are encoded") {
+            auto encoded = encode_normals(normals);
+
+            THEN("each normal takes two 16-bit values") {
+                REQUIRE(encoded.size() == 10);
+            }
+
+            THEN("decoding stays within a small angle of the source") {
+                auto decoded = decode_normals(encoded);
+                for (size_t vertex = 0; vertex < 5; ++vertex) {
+                    float dot = 0;
+                    for (size_t axis = 0; axis < 3; ++axis) {
+                        dot += normals[vertex * 3 + axis] * decoded[vertex * 3 + axis];
+                    }
+                    REQUIRE(dot > 0.99999f);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("formats are selected from the data", "[vertex_compression]") {
+    GIVEN("indices that fit in 16 bits and indices that do not") {
+        THEN("the narrowest width is chosen") {
+            REQUIRE(select_index_format({0, 1, 65535}) == IndexFormat::uint16);
+            REQUIRE(select_index_format({0, 1, 65536}) == IndexFormat::uint32);
+        }
+    }
+
+    GIVEN("uvs that do and do not survive half precision within a tolerance") {
+        THEN("half uvs are only chosen when every uv rounds within the tolerance") {
+            REQUIRE(select_mesh_format({0.0f, 1.0f}).uvs == UvFormat::half2);
+            REQUIRE(select_mesh_format({0.0f, 0.3f}).uvs == UvFormat::half2);
+            REQUIRE(select_mesh_format({0.0f, 1.9f}).uvs == UvFormat::float2);
+            REQUIRE(select_mesh_format({0.0f, 16.1f}).uvs == UvFormat::float2);
+        }
+
+        THEN("a looser tolerance admits coarser uvs and is recorded in the format") {
+            auto format = select_mesh_format({0.0f, 16.1f}, 0.01f);
+            REQUIRE(format.uvs == UvFormat::half2);
+            REQUIRE(format.uv_tolerance == 0.01f);
+            REQUIRE(select_mesh_format({0.0f, 0.3f}, 0.0f).uvs == UvFormat::float2);
+        }
+
+        THEN("normals are always octahedral") {
+            REQUIRE(select_mesh_format({}).normals == NormalFormat::octahedral);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch_all.hpp>
+#include <cask/resource/vertex_layout.hpp>
+
+SCENARIO("a vertex layout packs attributes in declaration order", "[vertex_layout]") {
+    GIVEN("a position, normal and uv layout") {
+        auto layout = make_vertex_layout({VertexAttribute::position, VertexAttribute::normal, VertexAttribute::uv});
+
+        THEN("offsets follow each attribute's size") {
+            REQUIRE(layout.elements.size() == 3);
+            REQUIRE(layout.elements[0].offset == 0);
+            REQUIRE(layout.elements[1].offset == 12);
+            REQUIRE(layout.elements[2].offset == 24);
+        }
+
+        THEN("the stride is the packed vertex size") {
+            REQUIRE(layout.stride == 32);
+        }
+    }
+
+    GIVEN("a layout with an explicit padded stride") {
+        auto layout = make_vertex_layout({VertexAttribute::position, VertexAttribute::uv}, 32);
+
+        THEN("the stride is kept") {
+            REQUIRE(layout.stride == 32);
+            REQUIRE(layout.elements[1].offset == 12);
+        }
+    }
+}
+
+SCENARIO("invalid vertex layouts are rejected", "[vertex_layout]") {
+    THEN("an empty layout throws") {
+        REQUIRE_THROWS(make_vertex_layout({}));
+    }
+
+    THEN("a stride smaller than the attributes throws") {
+        REQUIRE_THROWS(make_vertex_layout({VertexAttribute::position, VertexAttribute::normal}, 16));
+    }
+
+    THEN("a stride that is not a multiple of four throws") {
+        REQUIRE_THROWS(make_vertex_layout({VertexAttribute::position}, 13));
+    }
+}
+
+SCENARIO("hand-built vertex layouts are validated", "[vertex_layout]") {
+    THEN("a layout from make_vertex_layout passes") {
+        REQUIRE_NOTHROW(validate_vertex_layout(make_vertex_layout({VertexAttribute::uv, VertexAttribute::position}, 32)));
+    }
+
+    THEN("an element running past the stride throws") {
+        VertexLayout layout{{{VertexAttribute::position, 8}}, 16};
+        REQUIRE_THROWS_WITH(validate_vertex_layout(layout), "vertex element extends past the stride");
+    }
+
+    THEN("an offset near the top of the range does not wrap") {
+        VertexLayout layout{{{VertexAttribute::position, 0xFFFFFFFCu}}, 16};
+        REQUIRE_THROWS_WITH(validate_vertex_layout(layout), "vertex element extends past the stride");
+    }
+
+    THEN("overlapping elements throw") {
+        VertexLayout layout{{{VertexAttribute::position, 0}, {VertexAttribute::uv, 8}}, 32};
+        REQUIRE_THROWS_WITH(validate_vertex_layout(layout), "vertex layout elements overlap");
+    }
+
+    THEN("a layout without elements throws") {
+        REQUIRE_THROWS(validate_vertex_layout(VertexLayout{{}, 16}));
+    }
+}
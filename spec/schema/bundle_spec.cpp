@@ -131,7 +131,7 @@ SCENARIO("load_bundle returns context with entity_remap", "[bundle]") {
         EntityRegistry original_registry;
 
         auto uuid = cask::generate_uuid();
-        original_registry.resolve(uuid, original_table);
+        uint32_t original_entity = original_registry.resolve(uuid, original_table);
 
         auto reg_entry = cask::describe_entity_registry("EntityRegistry", original_table);
 
@@ -159,8 +159,8 @@ SCENARIO("load_bundle returns context with entity_remap", "[bundle]") {
         WHEN("load_bundle is called") {
             auto context = cask::load_bundle(bundle_data, serialization_registry, plugin_loader, resolver);
 
-            THEN("the context contains entity_remap") {
-                REQUIRE(context.contains("entity_remap"));
+            THEN("the context maps the file-local entity to the runtime entity") {
+                REQUIRE(context.entity_remap.at(original_entity) == fresh_registry.resolve(uuid, fresh_table));
             }
         }
     }
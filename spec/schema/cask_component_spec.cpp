@@ -2,6 +2,7 @@
 #include <cask/schema/cask_component.hpp>
 #include <cstdint>
 #include <string>
+#include <tuple>
 
 CASK_COMPONENT(Position, (float, x), (float, y), (float, z))
 
@@ -75,7 +76,8 @@ SCENARIO("CASK_COMPONENT serializes and deserializes", "[cask_component]") {
             auto data = entry.serialize(&original);
 
             Position restored{};
-            entry.deserialize(data, &restored, nlohmann::json::object());
+            cask::LoadContext context;
+            entry.deserialize(data, &restored, context);
 
             THEN("the restored position matches the original") {
                 REQUIRE(restored.x == Catch::Approx(original.x));
@@ -106,7 +108,12 @@ SCENARIO("CASK_COMPONENT works with mixed types", "[cask_component]") {
             auto data = entry.serialize(&original);
 
             GameState restored{};
-            entry.deserialize(data, &restored, nlohmann::json::object());
+            cask::LoadContext context;
+            entry.deserialize(data, &restored, context);
+
+            THEN("each value lands under its own key despite the declaration order") {
+                REQUIRE(data == nlohmann::json{{"score", 100}, {"time_remaining", 59.5}, {"paused", false}});
+            }
 
             THEN("all fields round-trip correctly") {
                 REQUIRE(restored.score == 100);
@@ -144,7 +151,8 @@ SCENARIO("CASK_COMPONENT works with a single field", "[cask_component]") {
             THEN("serialization round-trips correctly") {
                 auto data = entry.serialize(&item);
                 SingleField restored{};
-                entry.deserialize(data, &restored, nlohmann::json::object());
+                cask::LoadContext context;
+                entry.deserialize(data, &restored, context);
                 REQUIRE(restored.value == Catch::Approx(42.0));
             }
         }
@@ -168,7 +176,8 @@ SCENARIO("CASK_COMPONENT works with many fields", "[cask_component]") {
             THEN("serialization round-trips correctly") {
                 auto data = entry.serialize(&many);
                 ManyFields restored{};
-                entry.deserialize(data, &restored, nlohmann::json::object());
+                cask::LoadContext context;
+                entry.deserialize(data, &restored, context);
 
                 REQUIRE(restored.a == Catch::Approx(1.0f));
                 REQUIRE(restored.b == Catch::Approx(2.0f));
@@ -206,3 +215,39 @@ SCENARIO("CASK_COMPONENT describe matches manual describe", "[cask_component]")
         }
     }
 }
+
+SCENARIO("CASK_COMPONENT exposes a compile-time field table", "[cask_component]") {
+    GIVEN("a Position defined with CASK_COMPONENT") {
+        constexpr auto fields = Position::fields();
+
+        THEN("the table has one entry per field") {
+            STATIC_REQUIRE(std::tuple_size_v<decltype(fields)> == 3);
+        }
+
+        THEN("entries carry names") {
+            REQUIRE(std::string(std::get<0>(fields).name) == "x");
+            REQUIRE(std::string(std::get<2>(fields).name) == "z");
+        }
+
+        THEN("entries point at the declared members") {
+            Position pos{1.0f, 2.0f, 3.0f};
+            REQUIRE(pos.*(std::get<2>(fields).member) == Catch::Approx(3.0f));
+        }
+    }
+}
+
+SCENARIO("CASK_COMPONENT deserialization rejects missing fields", "[cask_component]") {
+    GIVEN("json data that lacks one of the declared fields") {
+        auto entry = Position::describe();
+        nlohmann::json data = {{"x", 1.0}, {"y", 2.0}};
+
+        WHEN("the json is deserialized") {
+            Position restored{};
+
+            THEN("it throws") {
+                cask::LoadContext context;
+                REQUIRE_THROWS(entry.deserialize(data, &restored, context));
+            }
+        }
+    }
+}
@@ -0,0 +1,258 @@
+#include <catch2/catch_all.hpp>
+#include <cask/ecs/component_store.hpp>
+#include <cask/platform/mapped_file.hpp>
+#include <cask/schema/component_column.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+struct Transform {
+    float pos_x;
+    float pos_y;
+    float pos_z;
+    float rot_y;
+    float scale;
+};
+
+ComponentStore<Transform> two_transforms() {
+    ComponentStore<Transform> store;
+    store.insert(42, Transform{1.0f, 2.0f, 3.0f, 0.5f, 1.0f});
+    store.insert(17, Transform{4.0f, 5.0f, 6.0f, 1.5f, 2.0f});
+    return store;
+}
+
+}
+
+SCENARIO("a component column round-trips through a binary image", "[component_column]") {
+    GIVEN("a component store with two transforms") {
+        auto original = two_transforms();
+
+        WHEN("the store is written to an image and read into an empty store") {
+            auto image = cask::write_column(original);
+
+            ComponentStore<Transform> restored;
+            cask::read_column<Transform>(image, restored);
+
+            THEN("the dense array matches the original") {
+                REQUIRE(restored.dense_.size() == 2);
+            }
+
+            THEN("entity 42 has the correct values") {
+                auto& transform = restored.get(42);
+                REQUIRE(transform.pos_x == Catch::Approx(1.0f));
+                REQUIRE(transform.pos_z == Catch::Approx(3.0f));
+                REQUIRE(transform.rot_y == Catch::Approx(0.5f));
+            }
+
+            THEN("entity 17 has the correct values") {
+                auto& transform = restored.get(17);
+                REQUIRE(transform.pos_y == Catch::Approx(5.0f));
+                REQUIRE(transform.scale == Catch::Approx(2.0f));
+            }
+        }
+    }
+}
+
+SCENARIO("reading a component column applies entity remapping", "[component_column]") {
+    GIVEN("an image of a store with file-local entities 42 and 17") {
+        auto image = cask::write_column(two_transforms());
+
+        WHEN("the image is read with a remap function") {
+            ComponentStore<Transform> restored;
+            cask::read_column<Transform>(image, restored, [](uint32_t entity) { return entity + 100; });
+
+            THEN("the store contains the remapped entities") {
+                REQUIRE(restored.has(142));
+                REQUIRE(restored.has(117));
+                REQUIRE_FALSE(restored.has(42));
+                REQUIRE(restored.get(142).pos_x == Catch::Approx(1.0f));
+            }
+        }
+    }
+}
+
+SCENARIO("reading a component column appends to a populated store", "[component_column]") {
+    GIVEN("a store that already holds an entity and an image of two more") {
+        ComponentStore<Transform> store;
+        store.insert(7, Transform{9.0f, 9.0f, 9.0f, 9.0f, 9.0f});
+        auto image = cask::write_column(two_transforms());
+
+        WHEN("the image is read into the store") {
+            cask::read_column<Transform>(image, store);
+
+            THEN("all three entities are present") {
+                REQUIRE(store.dense_.size() == 3);
+                REQUIRE(store.get(7).pos_x == Catch::Approx(9.0f));
+                REQUIRE(store.get(42).pos_x == Catch::Approx(1.0f));
+                REQUIRE(store.get(17).pos_x == Catch::Approx(4.0f));
+            }
+
+            THEN("removal still keeps the store consistent") {
+                store.remove(7);
+                REQUIRE(store.get(42).pos_x == Catch::Approx(1.0f));
+                REQUIRE(store.get(17).pos_x == Catch::Approx(4.0f));
+            }
+        }
+    }
+}
+
+SCENARIO("reading a component column rejects duplicate entities", "[component_column]") {
+    GIVEN("an image of two entities") {
+        auto image = cask::write_column(two_transforms());
+
+        WHEN("the store already holds one of them") {
+            ComponentStore<Transform> store;
+            store.insert(42, Transform{9.0f, 9.0f, 9.0f, 9.0f, 9.0f});
+
+            THEN("reading throws and leaves the store untouched") {
+                REQUIRE_THROWS_WITH(cask::read_column<Transform>(image, store), "column image entity is already in the store");
+                REQUIRE(store.dense_.size() == 1);
+                REQUIRE(store.index_to_entity_.size() == 1);
+            }
+        }
+
+        WHEN("the remap sends both entities to the same id") {
+            ComponentStore<Transform> store;
+
+            THEN("reading throws") {
+                REQUIRE_THROWS_WITH(
+                    cask::read_column<Transform>(image, store, [](uint32_t) { return 5u; }),
+                    "column image repeats an entity"
+                );
+                REQUIRE(store.dense_.empty());
+            }
+        }
+    }
+}
+
+SCENARIO("reading a component column is recorded on tracked stores", "[component_column]") {
+    GIVEN("a rebased store") {
+        ComponentStore<Transform> store;
+        store.rebase();
+
+        WHEN("an image is read into it") {
+            cask::read_column<Transform>(cask::write_column(two_transforms()), store);
+
+            THEN("each loaded entity is reported as inserted") {
+                REQUIRE(store.changes_.size() == 2);
+                REQUIRE(store.changes_.at(42) == ComponentChange::inserted);
+                REQUIRE(store.changes_.at(17) == ComponentChange::inserted);
+            }
+        }
+    }
+}
+
+SCENARIO("component column values are aligned within the image", "[component_column]") {
+    GIVEN("an image of a component store") {
+        auto image = cask::write_column(two_transforms());
+
+        WHEN("the header is read") {
+            auto header = cask::read_column_header<Transform>(image);
+
+            THEN("values start on a cache line boundary") {
+                REQUIRE(header.values_offset % cask::COLUMN_ALIGNMENT == 0);
+                REQUIRE(header.count == 2);
+                REQUIRE(header.stride == sizeof(Transform));
+            }
+        }
+    }
+}
+
+SCENARIO("reading a malformed component column throws", "[component_column]") {
+    GIVEN("a valid image of a component store") {
+        auto image = cask::write_column(two_transforms());
+        ComponentStore<Transform> store;
+
+        WHEN("the image is truncated") {
+            image.resize(image.size() - 1);
+
+            THEN("reading throws") {
+                REQUIRE_THROWS_WITH(cask::read_column<Transform>(image, store), Catch::Matchers::ContainsSubstring("truncated"));
+            }
+        }
+
+        WHEN("the magic is corrupted") {
+            image[0] = std::byte{0};
+
+            THEN("reading throws") {
+                REQUIRE_THROWS_WITH(cask::read_column<Transform>(image, store), Catch::Matchers::ContainsSubstring("magic"));
+            }
+        }
+
+        WHEN("the count is large enough to wrap the size check") {
+            cask::ColumnHeader header{};
+            std::memcpy(&header, image.data(), sizeof(header));
+            header.count = UINT64_MAX / sizeof(Transform) + 2;
+            std::memcpy(image.data(), &header, sizeof(header));
+
+            THEN("reading throws") {
+                REQUIRE_THROWS_WITH(cask::read_column<Transform>(image, store), Catch::Matchers::ContainsSubstring("truncated"));
+            }
+        }
+
+        WHEN("an offset points past the end of the image") {
+            cask::ColumnHeader header{};
+            std::memcpy(&header, image.data(), sizeof(header));
+            header.values_offset = UINT64_MAX - 63;
+            std::memcpy(image.data(), &header, sizeof(header));
+
+            THEN("reading throws") {
+                REQUIRE_THROWS_WITH(cask::read_column<Transform>(image, store), Catch::Matchers::ContainsSubstring("truncated"));
+            }
+        }
+
+        WHEN("the recorded alignment does not match the component") {
+            cask::ColumnHeader header{};
+            std::memcpy(&header, image.data(), sizeof(header));
+            header.alignment = 1;
+            std::memcpy(image.data(), &header, sizeof(header));
+
+            THEN("reading throws") {
+                REQUIRE_THROWS_WITH(cask::read_column<Transform>(image, store), Catch::Matchers::ContainsSubstring("alignment"));
+            }
+        }
+
+        WHEN("the image is read as a component of a different size") {
+            ComponentStore<float> floats;
+
+            THEN("reading throws") {
+                REQUIRE_THROWS_WITH(cask::read_column<float>(image, floats), Catch::Matchers::ContainsSubstring("stride"));
+            }
+        }
+    }
+}
+
+SCENARIO("a component column can be loaded from a memory-mapped file", "[component_column]") {
+    GIVEN("a column image written to disk") {
+        auto path = std::filesystem::temp_directory_path() / "cask_component_column_spec.col";
+        auto image = cask::write_column(two_transforms());
+        {
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        }
+
+        WHEN("the file is mapped and read") {
+            ComponentStore<Transform> restored;
+            {
+                cask::MappedFile mapped(path.string());
+                REQUIRE(mapped.bytes().size() == image.size());
+                cask::read_column<Transform>(mapped.bytes(), restored);
+            }
+
+            THEN("the store outlives the mapping with correct values") {
+                REQUIRE(restored.get(42).pos_y == Catch::Approx(2.0f));
+                REQUIRE(restored.get(17).rot_y == Catch::Approx(1.5f));
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+
+    GIVEN("a path that does not exist") {
+        THEN("mapping it throws") {
+            REQUIRE_THROWS(cask::MappedFile("/nonexistent/cask/column.col"));
+        }
+    }
+}
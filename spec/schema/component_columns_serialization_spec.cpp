@@ -0,0 +1,207 @@
+#include <catch2/catch_all.hpp>
+#include <cask/ecs/component_store.hpp>
+#include <cask/schema/cask_component.hpp>
+#include <cask/schema/describe_component_store.hpp>
+
+namespace {
+
+CASK_COMPONENT(Transform, (float, pos_x), (float, pos_y), (int32_t, layer))
+
+CASK_COMPONENT(Clashing, (float, entities))
+
+struct Marker {
+    static constexpr auto fields() { return std::make_tuple(); }
+};
+
+cask::LoadContext identity_remap(std::initializer_list<uint32_t> entities) {
+    cask::LoadContext context;
+    for (uint32_t entity : entities) {
+        context.entity_remap.set(entity, entity);
+    }
+    return context;
+}
+
+cask::RegistryEntry transform_columns_entry() {
+    return cask::describe_component_columns<Transform>("Transforms", Transform::describe());
+}
+
+}
+
+SCENARIO("component columns serialization emits one array per field", "[component_columns_serialization]") {
+    GIVEN("a component store with two entities") {
+        ComponentStore<Transform> store;
+        store.insert(42, Transform{1.0f, 2.0f, 3});
+        store.insert(17, Transform{4.0f, 5.0f, 6});
+
+        auto entry = transform_columns_entry();
+
+        WHEN("the store is serialized") {
+            auto data = entry.serialize(&store);
+
+            THEN("entities are listed in dense order") {
+                REQUIRE(data["entities"] == nlohmann::json::array({42, 17}));
+            }
+
+            THEN("each field is a column aligned with the entities") {
+                REQUIRE(data["pos_x"][0] == Catch::Approx(1.0));
+                REQUIRE(data["pos_x"][1] == Catch::Approx(4.0));
+                REQUIRE(data["pos_y"][1] == Catch::Approx(5.0));
+                REQUIRE(data["layer"] == nlohmann::json::array({3, 6}));
+            }
+        }
+    }
+}
+
+SCENARIO("component columns deserialization applies entity remapping", "[component_columns_serialization]") {
+    GIVEN("columnar json with file-local entities and a remap table") {
+        nlohmann::json data = {
+            {"entities", {42, 17}},
+            {"pos_x", {1.0, 4.0}},
+            {"pos_y", {2.0, 5.0}},
+            {"layer", {3, 6}}
+        };
+        cask::LoadContext context;
+        context.entity_remap.set(42, 100);
+        context.entity_remap.set(17, 200);
+
+        auto entry = transform_columns_entry();
+
+        WHEN("the json is deserialized") {
+            ComponentStore<Transform> store;
+            entry.deserialize(data, &store, context);
+
+            THEN("the store contains entries at the remapped entity IDs") {
+                REQUIRE(store.get(100).pos_x == Catch::Approx(1.0));
+                REQUIRE(store.get(100).layer == 3);
+                REQUIRE(store.get(200).pos_y == Catch::Approx(5.0));
+                REQUIRE(store.get(200).layer == 6);
+            }
+        }
+    }
+}
+
+SCENARIO("component columns round-trip with identity remap", "[component_columns_serialization]") {
+    GIVEN("a component store with entries") {
+        ComponentStore<Transform> original;
+        original.insert(3, Transform{7.0f, 8.0f, 9});
+        original.insert(5, Transform{-1.0f, -2.0f, -3});
+
+        auto entry = transform_columns_entry();
+
+        WHEN("the store is serialized then deserialized") {
+            auto data = entry.serialize(&original);
+            ComponentStore<Transform> restored;
+            auto context = identity_remap({3, 5});
+            entry.deserialize(data, &restored, context);
+
+            THEN("both entities round-trip correctly") {
+                REQUIRE(restored.get(3).pos_x == Catch::Approx(7.0));
+                REQUIRE(restored.get(3).layer == 9);
+                REQUIRE(restored.get(5).pos_y == Catch::Approx(-2.0));
+                REQUIRE(restored.get(5).layer == -3);
+            }
+        }
+    }
+}
+
+SCENARIO("component columns deserialization rejects malformed data", "[component_columns_serialization]") {
+    auto entry = transform_columns_entry();
+    ComponentStore<Transform> store;
+
+    GIVEN("a column shorter than the entity list") {
+        nlohmann::json data = {
+            {"entities", {42, 17}},
+            {"pos_x", {1.0}},
+            {"pos_y", {2.0, 5.0}},
+            {"layer", {3, 6}}
+        };
+
+        auto context = identity_remap({42, 17});
+
+        THEN("deserialization throws naming the column") {
+            REQUIRE_THROWS_WITH(
+                entry.deserialize(data, &store, context),
+                Catch::Matchers::ContainsSubstring("pos_x")
+            );
+        }
+    }
+
+    GIVEN("an entity missing from the remap table") {
+        nlohmann::json data = {
+            {"entities", {42}},
+            {"pos_x", {1.0}},
+            {"pos_y", {2.0}},
+            {"layer", {3}}
+        };
+
+        auto context = identity_remap({17});
+
+        THEN("deserialization throws") {
+            REQUIRE_THROWS(entry.deserialize(data, &store, context));
+        }
+    }
+}
+
+SCENARIO("component columns schema and dependencies", "[component_columns_serialization]") {
+    GIVEN("a described component columns entry") {
+        auto entry = transform_columns_entry();
+
+        THEN("it identifies as a component_columns container") {
+            REQUIRE(entry.schema["name"] == "Transforms");
+            REQUIRE(entry.schema["container"] == "component_columns");
+            REQUIRE(entry.schema["value_type"] == "Transform");
+        }
+
+        THEN("it depends on EntityRegistry") {
+            REQUIRE(entry.dependencies == std::vector<std::string>{"EntityRegistry"});
+        }
+    }
+
+    GIVEN("a component with a field named entities") {
+        THEN("describing its columns throws") {
+            REQUIRE_THROWS(cask::describe_component_columns<Clashing>("Clashing", Clashing::describe()));
+        }
+    }
+
+    GIVEN("a tag component with no fields") {
+        THEN("its columns describe without error") {
+            auto entry = cask::describe_component_columns<Marker>("Markers", cask::describe_static<Marker>("Marker"));
+            REQUIRE(entry.schema["value_type"] == "Marker");
+        }
+    }
+}
+
+SCENARIO("component columns deltas round-trip changed entities", "[component_columns_serialization]") {
+    GIVEN("a column store edited after its baseline and a replica of the baseline") {
+        ComponentStore<Transform> store;
+        store.insert(1, Transform{1.0f, 1.0f, 1});
+        store.insert(2, Transform{2.0f, 2.0f, 2});
+        store.rebase();
+        store.modify(2).layer = 7;
+        store.remove(1);
+
+        ComponentStore<Transform> replica;
+        replica.insert(1, Transform{1.0f, 1.0f, 1});
+        replica.insert(2, Transform{2.0f, 2.0f, 2});
+
+        auto entry = transform_columns_entry();
+        auto context = identity_remap({1, 2});
+
+        WHEN("the delta is applied to the replica") {
+            auto patch = entry.delta.serialize(&store);
+            entry.delta.apply(patch, &replica, context);
+
+            THEN("the patch holds one column row and one removal") {
+                REQUIRE(patch["upsert"]["entities"] == nlohmann::json::array({2}));
+                REQUIRE(patch["upsert"]["layer"] == nlohmann::json::array({7}));
+                REQUIRE(patch["remove"] == nlohmann::json::array({1}));
+            }
+
+            THEN("the replica matches the store") {
+                REQUIRE_FALSE(replica.has(1));
+                REQUIRE(replica.get(2).layer == 7);
+                REQUIRE(replica.dense_.size() == 1);
+            }
+        }
+    }
+}
@@ -19,12 +19,12 @@ cask::RegistryEntry position_entry() {
     });
 }
 
-nlohmann::json identity_remap(std::initializer_list<uint32_t> entities) {
-    nlohmann::json remap = nlohmann::json::object();
+cask::LoadContext identity_remap(std::initializer_list<uint32_t> entities) {
+    cask::LoadContext context;
     for (uint32_t entity : entities) {
-        remap[std::to_string(entity)] = entity;
+        context.entity_remap.set(entity, entity);
     }
-    return {{"entity_remap", remap}};
+    return context;
 }
 
 }
@@ -97,9 +97,9 @@ SCENARIO("component store deserialization applies entity remapping", "[component
             {"17", {{"x", 4.0}, {"y", 5.0}, {"z", 6.0}}}
         };
 
-        nlohmann::json context = {
-            {"entity_remap", {{"42", 100}, {"17", 200}}}
-        };
+        cask::LoadContext context;
+        context.entity_remap.set(42, 100);
+        context.entity_remap.set(17, 200);
 
         auto value_entry = position_entry();
         auto store_entry = cask::describe_component_store<Position>("Positions", value_entry);
@@ -135,8 +135,10 @@ SCENARIO("component store deserialization throws when remap table is missing", "
         WHEN("deserialization is attempted without entity_remap in context") {
             ComponentStore<Position> store;
 
+            cask::LoadContext context;
+
             THEN("it throws a descriptive error") {
-                REQUIRE_THROWS(store_entry.deserialize(data, &store, nlohmann::json{}));
+                REQUIRE_THROWS(store_entry.deserialize(data, &store, context));
             }
         }
     }
@@ -148,9 +150,8 @@ SCENARIO("component store deserialization throws when remap key is missing", "[c
             {"42", {{"x", 1.0}, {"y", 2.0}, {"z", 3.0}}}
         };
 
-        nlohmann::json context = {
-            {"entity_remap", {{"99", 100}}}
-        };
+        cask::LoadContext context;
+        context.entity_remap.set(99, 100);
 
         auto value_entry = position_entry();
         auto store_entry = cask::describe_component_store<Position>("Positions", value_entry);
@@ -247,23 +248,82 @@ SCENARIO("component store entry declares EntityRegistry dependency", "[component
     }
 }
 
-SCENARIO("component store deserialization returns empty context", "[component_store_serialization]") {
+SCENARIO("component store deserialization leaves the load context unchanged", "[component_store_serialization]") {
     GIVEN("json data and a valid remap context") {
         nlohmann::json data = {
             {"42", {{"x", 1.0}, {"y", 2.0}, {"z", 3.0}}}
         };
-        nlohmann::json context = {{"entity_remap", {{"42", 100}}}};
+        cask::LoadContext context;
+        context.entity_remap.set(42, 100);
 
         auto value_entry = position_entry();
         auto store_entry = cask::describe_component_store<Position>("Positions", value_entry);
 
         WHEN("the store is deserialized") {
             ComponentStore<Position> store;
-            auto contributions = store_entry.deserialize(data, &store, context);
+            store_entry.deserialize(data, &store, context);
+
+            THEN("the context holds only the original remap") {
+                REQUIRE(context.entity_remap.at(42) == 100);
+                REQUIRE_FALSE(context.entity_remap.has(100));
+                REQUIRE(context.resource_remaps.empty());
+            }
+        }
+    }
+}
 
-            THEN("the returned context contributions are empty") {
-                REQUIRE(contributions.empty());
+SCENARIO("component store deltas carry only changed entities", "[component_store_serialization]") {
+    GIVEN("a store edited after its baseline") {
+        ComponentStore<Position> store;
+        store.insert(1, Position{1.0f, 1.0f, 1.0f});
+        store.insert(2, Position{2.0f, 2.0f, 2.0f});
+        store.insert(3, Position{3.0f, 3.0f, 3.0f});
+        store.rebase();
+        store.modify(1).x = 10.0f;
+        store.insert(4, Position{4.0f, 4.0f, 4.0f});
+        store.remove(2);
+
+        auto store_entry = cask::describe_component_store<Position>("Positions", position_entry());
+
+        WHEN("the delta is serialized") {
+            auto patch = store_entry.delta.serialize(&store);
+
+            THEN("only touched entities are upserted and removals are listed") {
+                REQUIRE(patch["upsert"].size() == 2);
+                REQUIRE(patch["upsert"]["1"]["x"] == Catch::Approx(10.0));
+                REQUIRE(patch["upsert"].contains("4"));
+                REQUIRE(patch["remove"] == nlohmann::json::array({2}));
             }
         }
+
+        WHEN("the delta is applied to a copy of the baseline") {
+            ComponentStore<Position> replica;
+            replica.insert(1, Position{1.0f, 1.0f, 1.0f});
+            replica.insert(2, Position{2.0f, 2.0f, 2.0f});
+            replica.insert(3, Position{3.0f, 3.0f, 3.0f});
+            auto context = identity_remap({1, 2, 3, 4});
+
+            store_entry.delta.apply(store_entry.delta.serialize(&store), &replica, context);
+
+            THEN("the replica matches the edited store") {
+                REQUIRE(replica.dense_.size() == 3);
+                REQUIRE_FALSE(replica.has(2));
+                REQUIRE(replica.get(1).x == Catch::Approx(10.0));
+                REQUIRE(replica.get(3).x == Catch::Approx(3.0));
+                REQUIRE(replica.get(4).z == Catch::Approx(4.0));
+            }
+        }
+    }
+}
+
+SCENARIO("component store deltas require a baseline", "[component_store_serialization]") {
+    GIVEN("a store that was never rebased") {
+        ComponentStore<Position> store;
+        store.insert(1, Position{1.0f, 1.0f, 1.0f});
+        auto store_entry = cask::describe_component_store<Position>("Positions", position_entry());
+
+        THEN("serializing a delta throws") {
+            REQUIRE_THROWS_WITH(store_entry.delta.serialize(&store), Catch::Matchers::ContainsSubstring("baseline"));
+        }
     }
 }
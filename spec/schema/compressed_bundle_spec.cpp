@@ -0,0 +1,134 @@
+#include <catch2/catch_all.hpp>
+#include <cask/schema/compressed_bundle.hpp>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "../support/schema_fixtures.hpp"
+
+using fixtures::PhysicsConfig;
+using fixtures::physics_config_entry;
+
+namespace {
+
+nlohmann::json large_bundle(size_t count) {
+    nlohmann::json components = nlohmann::json::object();
+    for (size_t index = 0; index < count; ++index) {
+        components[std::to_string(index)] = {{"x", static_cast<double>(index)}, {"y", 0.5}, {"name", "entity"}};
+    }
+    return {{"plugins", {"alpha"}}, {"dependencies", nlohmann::json::object()}, {"components", {{"Positions", components}}}};
+}
+
+// A streambuf without seek support, standing in for a pipe or socket.
+struct PipeBuffer : std::streambuf {
+    std::string data_;
+
+    explicit PipeBuffer(std::string data) : data_(std::move(data)) {
+        setg(data_.data(), data_.data(), data_.data() + data_.size());
+    }
+};
+
+}
+
+SCENARIO("bundles round-trip through a zstd frame", "[compressed_bundle]") {
+    GIVEN("a bundle larger than one compression chunk") {
+        auto bundle = large_bundle(20'000);
+
+        WHEN("it is written compressed and read back") {
+            std::stringstream stream;
+            cask::write_bundle(stream, bundle, cask::BundleCompression::zstd);
+            std::string written = stream.str();
+            auto restored = cask::read_bundle(stream);
+
+            THEN("the payload is a zstd frame smaller than the json") {
+                REQUIRE(cask::is_zstd_frame(written));
+                REQUIRE(written.size() < bundle.dump().size() / 4);
+            }
+
+            THEN("the bundle is unchanged") {
+                REQUIRE(restored == bundle);
+            }
+        }
+
+        WHEN("it is written uncompressed") {
+            std::stringstream stream;
+            cask::write_bundle(stream, bundle);
+
+            THEN("it is plain json and still reads back") {
+                REQUIRE_FALSE(cask::is_zstd_frame(stream.str()));
+                REQUIRE(cask::read_bundle(stream) == bundle);
+            }
+        }
+
+        WHEN("a compressed bundle is truncated") {
+            std::stringstream stream;
+            cask::write_bundle(stream, bundle, cask::BundleCompression::zstd);
+            std::string written = stream.str();
+            std::stringstream truncated(written.substr(0, written.size() / 2));
+
+            THEN("reading it throws") {
+                REQUIRE_THROWS(cask::read_bundle(truncated));
+            }
+        }
+    }
+}
+
+SCENARIO("bundles are read from streams that cannot seek", "[compressed_bundle]") {
+    GIVEN("a plain json bundle behind a non-seekable buffer") {
+        PipeBuffer pipe(R"({"a":1})");
+        std::istream input(&pipe);
+
+        THEN("it reads back") {
+            REQUIRE(cask::read_bundle(input) == nlohmann::json{{"a", 1}});
+        }
+    }
+
+    GIVEN("a compressed bundle behind a non-seekable buffer") {
+        auto bundle = large_bundle(2'000);
+        std::stringstream stream;
+        cask::write_bundle(stream, bundle, cask::BundleCompression::zstd);
+        PipeBuffer pipe(stream.str());
+        std::istream input(&pipe);
+
+        THEN("it reads back") {
+            REQUIRE(cask::read_bundle(input) == bundle);
+        }
+    }
+
+    GIVEN("a stream shorter than the frame magic") {
+        PipeBuffer pipe("1");
+        std::istream input(&pipe);
+
+        THEN("it is parsed as json") {
+            REQUIRE(cask::read_bundle(input) == nlohmann::json(1));
+        }
+    }
+}
+
+SCENARIO("save_bundle and load_bundle stream compressed bundles", "[compressed_bundle]") {
+    GIVEN("a registry with a singleton component") {
+        PhysicsConfig config{9.8f};
+        cask::SerializationRegistry registry;
+        registry.add("PhysicsConfig", physics_config_entry());
+
+        WHEN("a compressed bundle is saved and loaded into a fresh component") {
+            std::stringstream stream;
+            cask::save_bundle(stream, {"alpha"}, {"PhysicsConfig"}, registry, [&](const std::string&) -> void* {
+                return &config;
+            }, cask::BundleCompression::zstd);
+
+            PhysicsConfig restored{};
+            std::vector<std::string> plugins;
+            cask::load_bundle(stream, registry, [&](const std::string& name) {
+                plugins.push_back(name);
+            }, [&](const std::string&) -> void* {
+                return &restored;
+            });
+
+            THEN("plugins and components are restored") {
+                REQUIRE(plugins == std::vector<std::string>{"alpha"});
+                REQUIRE(restored.gravity == Catch::Approx(9.8));
+            }
+        }
+    }
+}
@@ -93,7 +93,8 @@ SCENARIO("describe produces working deserialize function", "[describe]") {
 
         WHEN("the json is deserialized into a Position") {
             Position pos{};
-            entry.deserialize(data, &pos, nlohmann::json{});
+            cask::LoadContext context;
+            entry.deserialize(data, &pos, context);
 
             THEN("the position has the correct values") {
                 REQUIRE(pos.x == Catch::Approx(4.0));
@@ -117,7 +118,8 @@ SCENARIO("describe round-trips serialization", "[describe]") {
             auto data = entry.serialize(&original);
 
             Position restored{};
-            entry.deserialize(data, &restored, nlohmann::json{});
+            cask::LoadContext context;
+            entry.deserialize(data, &restored, context);
 
             THEN("the restored position matches the original") {
                 REQUIRE(restored.x == Catch::Approx(original.x));
@@ -141,13 +143,21 @@ SCENARIO("describe works with mixed types including padding", "[describe]") {
             auto data = entry.serialize(&original);
 
             Mixed restored{};
-            entry.deserialize(data, &restored, nlohmann::json{});
+            cask::LoadContext context;
+            entry.deserialize(data, &restored, context);
 
             THEN("all fields round-trip correctly") {
                 REQUIRE(restored.id == 42);
                 REQUIRE(restored.value == Catch::Approx(3.14f));
                 REQUIRE(restored.active == true);
             }
+
+            THEN("each key holds its own field even though keys sort differently from declaration order") {
+                REQUIRE(data.size() == 3);
+                REQUIRE(data["id"] == 42);
+                REQUIRE(data["value"].get<float>() == Catch::Approx(3.14f));
+                REQUIRE(data["active"] == true);
+            }
         }
 
         WHEN("the schema is inspected") {
@@ -204,3 +214,24 @@ SCENARIO("describe rejects overlapping fields", "[describe]") {
         }
     }
 }
+
+SCENARIO("describe deserialization throws when a field is missing", "[describe]") {
+    GIVEN("a described Position entry and json lacking the z field") {
+        auto entry = cask::describe<Position>("Position", {
+            cask::field("x", &Position::x),
+            cask::field("y", &Position::y),
+            cask::field("z", &Position::z)
+        });
+
+        nlohmann::json data = {{"x", 1.0}, {"y", 2.0}};
+
+        WHEN("the json is deserialized") {
+            Position pos{};
+
+            THEN("it throws") {
+                cask::LoadContext context;
+                REQUIRE_THROWS(entry.deserialize(data, &pos, context));
+            }
+        }
+    }
+}
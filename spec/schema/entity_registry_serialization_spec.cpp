@@ -47,7 +47,8 @@ SCENARIO("entity registry deserialization resolves UUIDs and produces remap cont
         auto entry = cask::describe_entity_registry("EntityRegistry", fresh_table);
 
         WHEN("the json is deserialized into the fresh registry") {
-            auto context = entry.deserialize(data, &fresh_registry, nlohmann::json{});
+            cask::LoadContext context;
+            entry.deserialize(data, &fresh_registry, context);
 
             THEN("the fresh registry resolves the same UUIDs") {
                 REQUIRE(fresh_registry.size() == 2);
@@ -55,17 +56,17 @@ SCENARIO("entity registry deserialization resolves UUIDs and produces remap cont
                 REQUIRE(fresh_registry.has(fresh_registry.resolve(uuid_b, fresh_table)));
             }
 
-            THEN("the returned context contains entity_remap") {
-                REQUIRE(context.contains("entity_remap"));
+            THEN("the context records both file-local IDs") {
+                REQUIRE(context.entity_remap.has(42));
+                REQUIRE(context.entity_remap.has(17));
             }
 
             THEN("the remap maps file-local IDs to new runtime IDs") {
-                auto remap = context["entity_remap"];
                 uint32_t runtime_a = fresh_registry.resolve(uuid_a, fresh_table);
                 uint32_t runtime_b = fresh_registry.resolve(uuid_b, fresh_table);
 
-                REQUIRE(remap["42"] == runtime_a);
-                REQUIRE(remap["17"] == runtime_b);
+                REQUIRE(context.entity_remap.at(42) == runtime_a);
+                REQUIRE(context.entity_remap.at(17) == runtime_b);
             }
         }
     }
@@ -101,7 +102,8 @@ SCENARIO("entity registry round-trips with new runtime IDs", "[entity_registry_s
             EntityRegistry fresh_registry;
             auto fresh_entry = cask::describe_entity_registry("EntityRegistry", fresh_table);
 
-            fresh_entry.deserialize(data, &fresh_registry, nlohmann::json{});
+            cask::LoadContext context;
+            fresh_entry.deserialize(data, &fresh_registry, context);
 
             THEN("the fresh registry has the same UUIDs") {
                 REQUIRE(fresh_registry.size() == 2);
@@ -77,8 +77,9 @@ SCENARIO("loader deserializes components in dependency order", "[loader]") {
                 REQUIRE(pos_b.y == Catch::Approx(4.0));
             }
 
-            THEN("the context contains entity_remap") {
-                REQUIRE(context.contains("entity_remap"));
+            THEN("the context maps file-local entities to runtime entities") {
+                REQUIRE(context.entity_remap.at(original_a) == fresh_registry.resolve(uuid_a, fresh_table));
+                REQUIRE(context.entity_remap.at(original_b) == fresh_registry.resolve(uuid_b, fresh_table));
             }
         }
     }
@@ -130,7 +131,7 @@ SCENARIO("loader detects circular dependencies", "[loader]") {
         cask::RegistryEntry dummy{
             nlohmann::json{{"name", "dummy"}},
             [](const void*) { return nlohmann::json{}; },
-            [](const nlohmann::json&, void*, const nlohmann::json&) { return nlohmann::json::object(); },
+            [](const nlohmann::json&, void*, cask::LoadContext&) {},
             {}
         };
 
@@ -150,3 +151,76 @@ SCENARIO("loader detects circular dependencies", "[loader]") {
         }
     }
 }
+
+SCENARIO("component graphs order ids by their dependencies", "[loader]") {
+    GIVEN("a graph where the first component depends on the last") {
+        cask::ComponentGraph graph(3);
+        graph.add(0);
+        graph.add(1);
+        graph.add(2);
+        graph.depend(0, 2);
+
+        WHEN("it is sorted") {
+            auto order = graph.sorted();
+
+            THEN("independent components keep file order and dependents follow their dependency") {
+                REQUIRE(order == std::vector<uint32_t>{1, 2, 0});
+            }
+        }
+    }
+
+    GIVEN("a graph whose component depends on one missing from the file") {
+        cask::ComponentGraph graph(2);
+        graph.add(0);
+        graph.depend(0, 1);
+
+        THEN("sorting throws") {
+            REQUIRE_THROWS_WITH(graph.sorted(), Catch::Matchers::ContainsSubstring("circular dependency"));
+        }
+    }
+}
+
+SCENARIO("loader rejects components missing from the registry", "[loader]") {
+    GIVEN("file data naming an unregistered component") {
+        nlohmann::json file_data = {
+            {"dependencies", nlohmann::json::object()},
+            {"components", {{"Unknown", nlohmann::json::object()}}}
+        };
+        cask::SerializationRegistry serialization_registry;
+
+        THEN("load throws naming the component") {
+            REQUIRE_THROWS_WITH(
+                cask::load(file_data, serialization_registry, cask::ComponentTable{}),
+                Catch::Matchers::ContainsSubstring("Unknown")
+            );
+        }
+    }
+}
+
+SCENARIO("loader rejects components with no bound instance", "[loader]") {
+    GIVEN("a registered component the table has no instance for") {
+        nlohmann::json file_data = {
+            {"dependencies", nlohmann::json::object()},
+            {"components", {{"PhysicsConfig", {{"gravity", 9.8}}}}}
+        };
+        cask::SerializationRegistry serialization_registry;
+        serialization_registry.add("PhysicsConfig", physics_config_entry());
+
+        THEN("load throws naming the component") {
+            REQUIRE_THROWS_WITH(
+                cask::load(file_data, serialization_registry, cask::ComponentTable{}),
+                Catch::Matchers::ContainsSubstring("PhysicsConfig")
+            );
+        }
+
+        THEN("load_delta throws naming the component") {
+            nlohmann::json patch = file_data;
+            patch[cask::DELTA_KEY] = true;
+            cask::LoadContext context;
+            REQUIRE_THROWS_WITH(
+                cask::load_delta(patch, serialization_registry, cask::ComponentTable{}, context),
+                Catch::Matchers::ContainsSubstring("PhysicsConfig")
+            );
+        }
+    }
+}
@@ -0,0 +1,394 @@
+#include <catch2/catch_all.hpp>
+#include <cask/ecs/component_store.hpp>
+#include <cask/ecs/entity_table.hpp>
+#include <cask/identity/entity_registry.hpp>
+#include <cask/identity/uuid.hpp>
+#include <cask/schema/describe_component_store.hpp>
+#include <cask/schema/describe_entity_registry.hpp>
+#include <cask/schema/parallel_loader.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "../support/rendezvous.hpp"
+#include "../support/schema_fixtures.hpp"
+
+using fixtures::Position;
+using fixtures::position_entry;
+
+namespace {
+
+struct Velocity {
+    float dx;
+    float dy;
+};
+
+cask::RegistryEntry velocity_entry() {
+    return cask::describe<Velocity>("Velocity", {
+        cask::field("dx", &Velocity::dx),
+        cask::field("dy", &Velocity::dy)
+    });
+}
+
+struct Recorder {
+    std::mutex mutex_;
+    std::vector<std::string> order_;
+
+    void record(const std::string& name) {
+        std::lock_guard lock(mutex_);
+        order_.push_back(name);
+    }
+
+    size_t position(const std::string& name) {
+        std::lock_guard lock(mutex_);
+        return std::find(order_.begin(), order_.end(), name) - order_.begin();
+    }
+};
+
+cask::RegistryEntry recording_entry(const std::string& name, Recorder& recorder) {
+    return cask::RegistryEntry{
+        nlohmann::json{{"name", name}},
+        [](const void*) { return nlohmann::json{}; },
+        [name, &recorder](const nlohmann::json&, void*, cask::LoadContext&) {
+            recorder.record(name);
+        },
+        {}
+    };
+}
+
+}
+
+SCENARIO("parallel loader deserializes independent stores after their shared dependency", "[parallel_loader]") {
+    GIVEN("a saved world with an entity registry and two component stores") {
+        EntityTable table;
+        EntityRegistry registry;
+
+        auto uuid_a = cask::generate_uuid();
+        auto uuid_b = cask::generate_uuid();
+        uint32_t original_a = registry.resolve(uuid_a, table);
+        uint32_t original_b = registry.resolve(uuid_b, table);
+
+        auto position_value = position_entry();
+        auto velocity_value = velocity_entry();
+        auto positions_entry = cask::describe_component_store<Position>("Positions", position_value);
+        auto velocities_entry = cask::describe_component_store<Velocity>("Velocities", velocity_value);
+        auto reg_entry = cask::describe_entity_registry("EntityRegistry", table);
+
+        ComponentStore<Position> original_positions;
+        original_positions.insert(original_a, Position{1.0f, 2.0f});
+        original_positions.insert(original_b, Position{3.0f, 4.0f});
+
+        ComponentStore<Velocity> original_velocities;
+        original_velocities.insert(original_b, Velocity{5.0f, 6.0f});
+
+        nlohmann::json file_data = {
+            {"dependencies", {
+                {"Positions", {"EntityRegistry"}},
+                {"Velocities", {"EntityRegistry"}}
+            }},
+            {"components", {
+                {"EntityRegistry", reg_entry.serialize(&registry)},
+                {"Positions", positions_entry.serialize(&original_positions)},
+                {"Velocities", velocities_entry.serialize(&original_velocities)}
+            }}
+        };
+
+        EntityTable fresh_table;
+        EntityRegistry fresh_registry;
+        ComponentStore<Position> fresh_positions;
+        ComponentStore<Velocity> fresh_velocities;
+
+        cask::SerializationRegistry serialization_registry;
+        serialization_registry.add("EntityRegistry", cask::describe_entity_registry("EntityRegistry", fresh_table));
+        serialization_registry.add("Positions", positions_entry);
+        serialization_registry.add("Velocities", velocities_entry);
+
+        cask::ComponentResolver resolver = [&](const std::string& name) -> void* {
+            if (name == "EntityRegistry") return &fresh_registry;
+            if (name == "Positions") return &fresh_positions;
+            if (name == "Velocities") return &fresh_velocities;
+            return nullptr;
+        };
+
+        auto thread_count = GENERATE(0u, 1u, 4u);
+        cask::WorkerPool pool(thread_count);
+
+        WHEN("the file is loaded in parallel") {
+            auto context = cask::load_parallel(file_data, serialization_registry, resolver, pool);
+
+            THEN("both stores hold the remapped data") {
+                uint32_t runtime_a = fresh_registry.resolve(uuid_a, fresh_table);
+                uint32_t runtime_b = fresh_registry.resolve(uuid_b, fresh_table);
+
+                REQUIRE(fresh_positions.get(runtime_a).x == Catch::Approx(1.0));
+                REQUIRE(fresh_positions.get(runtime_b).y == Catch::Approx(4.0));
+                REQUIRE(fresh_velocities.get(runtime_b).dx == Catch::Approx(5.0));
+                REQUIRE_FALSE(fresh_velocities.has(runtime_a));
+            }
+
+            THEN("the context maps file-local entities to runtime entities") {
+                REQUIRE(context.entity_remap.at(original_a) == fresh_registry.resolve(uuid_a, fresh_table));
+                REQUIRE(context.entity_remap.at(original_b) == fresh_registry.resolve(uuid_b, fresh_table));
+            }
+        }
+    }
+}
+
+SCENARIO("parallel loader respects dependency chains", "[parallel_loader]") {
+    GIVEN("a chain C depends on B depends on A and an independent D") {
+        Recorder recorder;
+
+        nlohmann::json file_data = {
+            {"dependencies", {
+                {"B", {"A"}},
+                {"C", {"B"}}
+            }},
+            {"components", {
+                {"A", nlohmann::json::object()},
+                {"B", nlohmann::json::object()},
+                {"C", nlohmann::json::object()},
+                {"D", nlohmann::json::object()}
+            }}
+        };
+
+        cask::SerializationRegistry serialization_registry;
+        for (const char* name : {"A", "B", "C", "D"}) {
+            serialization_registry.add(name, recording_entry(name, recorder));
+        }
+
+        int dummy = 0;
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &dummy; };
+        cask::WorkerPool pool(3);
+
+        WHEN("the file is loaded in parallel") {
+            cask::load_parallel(file_data, serialization_registry, resolver, pool);
+
+            THEN("every section is deserialized once") {
+                REQUIRE(recorder.order_.size() == 4);
+            }
+
+            THEN("each section follows its dependency") {
+                REQUIRE(recorder.position("A") < recorder.position("B"));
+                REQUIRE(recorder.position("B") < recorder.position("C"));
+            }
+        }
+    }
+}
+
+SCENARIO("parallel loader overlaps sections that do not depend on each other", "[parallel_loader]") {
+    GIVEN("two independent sections that wait for each other to start") {
+        Rendezvous rendezvous(2);
+
+        cask::RegistryEntry waiting{
+            nlohmann::json{{"name", "rendezvous"}},
+            [](const void*) { return nlohmann::json{}; },
+            [&rendezvous](const nlohmann::json&, void*, cask::LoadContext&) { rendezvous.arrive(); },
+            {}
+        };
+
+        cask::SerializationRegistry serialization_registry;
+        serialization_registry.add("Meshes", waiting);
+        serialization_registry.add("Transforms", waiting);
+
+        nlohmann::json file_data = {
+            {"dependencies", nlohmann::json::object()},
+            {"components", {
+                {"Meshes", nlohmann::json::object()},
+                {"Transforms", nlohmann::json::object()}
+            }}
+        };
+
+        int dummy = 0;
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &dummy; };
+        cask::WorkerPool pool(2);
+
+        WHEN("the file is loaded in parallel") {
+            cask::load_parallel(file_data, serialization_registry, resolver, pool);
+
+            THEN("the sections ran at the same time") {
+                REQUIRE(rendezvous.overlapped == 2);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel loader serializes sections that share external state", "[parallel_loader]") {
+    GIVEN("three independent sections that mutate the same store") {
+        int shared_store = 0;
+        std::atomic<int> active{0};
+        std::atomic<int> peak{0};
+        std::atomic<int> ran{0};
+
+        cask::RegistryEntry writer{
+            nlohmann::json{{"name", "writer"}},
+            [](const void*) { return nlohmann::json{}; },
+            [&](const nlohmann::json&, void*, cask::LoadContext&) {
+                int now = ++active;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                --active;
+                ++ran;
+            },
+            {}
+        };
+        writer.shared_state = {&shared_store};
+
+        cask::SerializationRegistry serialization_registry;
+        serialization_registry.add("MeshRefs", writer);
+        serialization_registry.add("ShadowMeshRefs", writer);
+        serialization_registry.add("DecalMeshRefs", writer);
+
+        nlohmann::json file_data = {
+            {"dependencies", nlohmann::json::object()},
+            {"components", {
+                {"MeshRefs", nlohmann::json::object()},
+                {"ShadowMeshRefs", nlohmann::json::object()},
+                {"DecalMeshRefs", nlohmann::json::object()}
+            }}
+        };
+
+        int dummy = 0;
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &dummy; };
+        cask::WorkerPool pool(3);
+
+        WHEN("the file is loaded in parallel") {
+            cask::load_parallel(file_data, serialization_registry, resolver, pool);
+
+            THEN("every section ran, one at a time") {
+                REQUIRE(ran == 3);
+                REQUIRE(peak == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel loader propagates deserialization errors", "[parallel_loader]") {
+    GIVEN("a section whose deserializer throws and a dependent section") {
+        Recorder recorder;
+
+        cask::RegistryEntry failing{
+            nlohmann::json{{"name", "Broken"}},
+            [](const void*) { return nlohmann::json{}; },
+            [](const nlohmann::json&, void*, cask::LoadContext&) {
+                throw std::runtime_error("broken section");
+            },
+            {}
+        };
+
+        cask::SerializationRegistry serialization_registry;
+        serialization_registry.add("Broken", failing);
+        serialization_registry.add("Dependent", recording_entry("Dependent", recorder));
+
+        nlohmann::json file_data = {
+            {"dependencies", {
+                {"Dependent", {"Broken"}}
+            }},
+            {"components", {
+                {"Broken", nlohmann::json::object()},
+                {"Dependent", nlohmann::json::object()}
+            }}
+        };
+
+        int dummy = 0;
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &dummy; };
+        cask::WorkerPool pool(2);
+
+        THEN("loading rethrows the error and skips the dependent section") {
+            REQUIRE_THROWS_WITH(
+                cask::load_parallel(file_data, serialization_registry, resolver, pool),
+                Catch::Matchers::ContainsSubstring("broken section")
+            );
+            REQUIRE(recorder.order_.empty());
+        }
+    }
+
+    GIVEN("a file with a circular dependency") {
+        Recorder recorder;
+
+        cask::SerializationRegistry serialization_registry;
+        serialization_registry.add("A", recording_entry("A", recorder));
+        serialization_registry.add("B", recording_entry("B", recorder));
+
+        nlohmann::json file_data = {
+            {"dependencies", {
+                {"A", {"B"}},
+                {"B", {"A"}}
+            }},
+            {"components", {
+                {"A", nlohmann::json::object()},
+                {"B", nlohmann::json::object()}
+            }}
+        };
+
+        int dummy = 0;
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &dummy; };
+        cask::WorkerPool pool(2);
+
+        THEN("loading throws before deserializing anything") {
+            REQUIRE_THROWS(cask::load_parallel(file_data, serialization_registry, resolver, pool));
+            REQUIRE(recorder.order_.empty());
+        }
+    }
+}
+
+SCENARIO("parallel loader rejects components with no bound instance", "[parallel_loader]") {
+    GIVEN("one bound and one unbound section") {
+        Recorder recorder;
+
+        cask::SerializationRegistry serialization_registry;
+        uint32_t bound = serialization_registry.add("Bound", recording_entry("Bound", recorder));
+        serialization_registry.add("Unbound", recording_entry("Unbound", recorder));
+
+        nlohmann::json file_data = {
+            {"dependencies", nlohmann::json::object()},
+            {"components", {
+                {"Bound", nlohmann::json::object()},
+                {"Unbound", nlohmann::json::object()}
+            }}
+        };
+
+        int dummy = 0;
+        cask::ComponentTable components;
+        components.bind(bound, &dummy);
+        cask::WorkerPool pool(2);
+
+        THEN("loading throws naming the section before dispatching any") {
+            REQUIRE_THROWS_WITH(
+                cask::load_parallel(file_data, serialization_registry, components, pool),
+                Catch::Matchers::ContainsSubstring("Unbound")
+            );
+            REQUIRE(recorder.order_.empty());
+        }
+    }
+}
+
+SCENARIO("parallel loader rejects delta saves", "[parallel_loader]") {
+    GIVEN("a file flagged as a delta") {
+        Recorder recorder;
+
+        cask::SerializationRegistry serialization_registry;
+        uint32_t section = serialization_registry.add("Section", recording_entry("Section", recorder));
+
+        nlohmann::json file_data = {
+            {cask::DELTA_KEY, true},
+            {"dependencies", nlohmann::json::object()},
+            {"components", {{"Section", nlohmann::json::object()}}}
+        };
+
+        int dummy = 0;
+        cask::ComponentTable components;
+        components.bind(section, &dummy);
+        cask::WorkerPool pool(2);
+
+        THEN("loading throws before dispatching any section") {
+            REQUIRE_THROWS_WITH(
+                cask::load_parallel(file_data, serialization_registry, components, pool),
+                "delta saves must be applied with load_delta"
+            );
+            REQUIRE(recorder.order_.empty());
+        }
+    }
+}
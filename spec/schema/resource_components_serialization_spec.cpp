@@ -10,24 +10,27 @@ struct FakeResource {
     int data;
 };
 
-nlohmann::json build_context(
-    std::initializer_list<std::pair<std::string, uint32_t>> entity_pairs,
+cask::LoadContext build_context(
+    std::initializer_list<std::pair<uint32_t, uint32_t>> entity_pairs,
     const std::string& sources_name,
     std::initializer_list<std::pair<std::string, uint32_t>> resource_pairs) {
-    nlohmann::json entity_remap = nlohmann::json::object();
-    for (const auto& [key, value] : entity_pairs) {
-        entity_remap[key] = value;
+    cask::LoadContext context;
+    for (const auto& [file_id, runtime_id] : entity_pairs) {
+        context.entity_remap.set(file_id, runtime_id);
     }
 
-    nlohmann::json resource_remap = nlohmann::json::object();
+    auto& resource_remap = context.resource_remaps[sources_name];
     for (const auto& [key, value] : resource_pairs) {
         resource_remap[key] = value;
     }
 
-    return {
-        {"entity_remap", entity_remap},
-        {"resource_remap_" + sources_name, resource_remap}
-    };
+    return context;
+}
+
+void fill_store(ResourceStore<FakeResource>& store, uint32_t count) {
+    for (uint32_t index = 0; index < count; ++index) {
+        store.store("resource_" + std::to_string(index), FakeResource{static_cast<int>(index)});
+    }
 }
 
 }
@@ -68,12 +71,13 @@ SCENARIO("resource components deserialization resolves entity and resource remap
         };
 
         auto context = build_context(
-            {{"10", 100}, {"20", 200}},
+            {{10, 100}, {20, 200}},
             "MeshSources",
             {{"wall_mesh", 5}, {"floor_mesh", 7}}
         );
 
         ResourceStore<FakeResource> resource_store;
+        fill_store(resource_store, 8);
         auto entry = cask::describe_resource_components<FakeResource>("MeshComponents", "MeshSources", resource_store);
 
         WHEN("the json is deserialized") {
@@ -100,12 +104,13 @@ SCENARIO("resource components deserialization with identity entity remap", "[res
         };
 
         auto context = build_context(
-            {{"42", 42}},
+            {{42, 42}},
             "MeshSources",
             {{"wall_mesh", 3}}
         );
 
         ResourceStore<FakeResource> resource_store;
+        fill_store(resource_store, 4);
         auto entry = cask::describe_resource_components<FakeResource>("MeshComponents", "MeshSources", resource_store);
 
         WHEN("the json is deserialized") {
@@ -116,6 +121,10 @@ SCENARIO("resource components deserialization with identity entity remap", "[res
                 REQUIRE(comp_store.has(42));
                 REQUIRE(comp_store.get(42).value == 3);
             }
+
+            THEN("the resource store counts the reference") {
+                REQUIRE(resource_store.ref_count(ResourceHandle<FakeResource>{3}) == 1);
+            }
         }
     }
 }
@@ -126,9 +135,8 @@ SCENARIO("resource components deserialization throws when entity_remap is missin
             {"42", "wall_mesh"}
         };
 
-        nlohmann::json context = {
-            {"resource_remap_MeshSources", {{"wall_mesh", 3}}}
-        };
+        cask::LoadContext context;
+        context.resource_remaps["MeshSources"]["wall_mesh"] = 3;
 
         ResourceStore<FakeResource> resource_store;
         auto entry = cask::describe_resource_components<FakeResource>("MeshComponents", "MeshSources", resource_store);
@@ -149,9 +157,8 @@ SCENARIO("resource components deserialization throws when resource_remap is miss
             {"42", "wall_mesh"}
         };
 
-        nlohmann::json context = {
-            {"entity_remap", {{"42", 42}}}
-        };
+        cask::LoadContext context;
+        context.entity_remap.set(42, 42);
 
         ResourceStore<FakeResource> resource_store;
         auto entry = cask::describe_resource_components<FakeResource>("MeshComponents", "MeshSources", resource_store);
@@ -238,7 +245,7 @@ SCENARIO("resource components round-trips through serialization", "[resource_com
             auto data = entry.serialize(&original);
 
             auto context = build_context(
-                {{"42", 42}, {"17", 17}},
+                {{42, 42}, {17, 17}},
                 "MeshSources",
                 {{"wall_mesh", wall_handle.value}, {"floor_mesh", floor_handle.value}}
             );
@@ -3,6 +3,8 @@
 #include <cask/resource/resource_sources.hpp>
 #include <cask/resource/resource_store.hpp>
 #include <cask/schema/describe_resource_sources.hpp>
+#include <stdexcept>
+#include "../support/rendezvous.hpp"
 
 namespace {
 
@@ -61,7 +63,8 @@ SCENARIO("resource sources deserialization invokes named loaders and stores resu
 
         WHEN("the json is deserialized") {
             ResourceSources<FakeResource> sources;
-            entry.deserialize(data, &sources, nlohmann::json{});
+            cask::LoadContext context;
+            entry.deserialize(data, &sources, context);
 
             THEN("each named loader was invoked with its full entry json") {
                 REQUIRE(invocations.size() == 2);
@@ -85,8 +88,8 @@ SCENARIO("resource sources deserialization invokes named loaders and stores resu
             THEN("the resource store contains the loaded resources") {
                 auto wall_handle = store.key_to_handle_.at("wall_mesh");
                 auto cube_handle = store.key_to_handle_.at("unit_cube");
-                REQUIRE(store.resources_[wall_handle].data == static_cast<int>(std::string("meshes/wall.obj").size()));
-                REQUIRE(store.resources_[cube_handle].data == 42);
+                REQUIRE(store.get(store.handle(wall_handle)).data == static_cast<int>(std::string("meshes/wall.obj").size()));
+                REQUIRE(store.get(store.handle(cube_handle)).data == 42);
             }
 
             THEN("the sources entries are populated with json specs") {
@@ -116,16 +119,17 @@ SCENARIO("resource sources deserialization produces resource remap context", "[r
 
         WHEN("the json is deserialized") {
             ResourceSources<FakeResource> sources;
-            auto context = entry.deserialize(data, &sources, nlohmann::json{});
+            cask::LoadContext context;
+            entry.deserialize(data, &sources, context);
 
-            THEN("the returned context contains resource_remap_MeshSources") {
-                REQUIRE(context.contains("resource_remap_MeshSources"));
+            THEN("the context contains a resource remap for MeshSources") {
+                REQUIRE(context.resource_remaps.count("MeshSources") == 1);
             }
 
             THEN("the remap maps keys to handle values") {
-                auto remap = context["resource_remap_MeshSources"];
+                const auto& remap = context.resource_remaps.at("MeshSources");
                 auto handle_value = store.key_to_handle_.at("wall_mesh");
-                REQUIRE(remap["wall_mesh"] == handle_value);
+                REQUIRE(remap.at("wall_mesh") == handle_value);
             }
         }
     }
@@ -143,10 +147,11 @@ SCENARIO("resource sources deserialization throws for unknown loader", "[resourc
 
         WHEN("the json is deserialized") {
             ResourceSources<FakeResource> sources;
+            cask::LoadContext context;
 
             THEN("it throws with a message containing the loader name") {
                 REQUIRE_THROWS_WITH(
-                    entry.deserialize(data, &sources, nlohmann::json{}),
+                    entry.deserialize(data, &sources, context),
                     Catch::Matchers::ContainsSubstring("unknown_format")
                 );
             }
@@ -222,7 +227,8 @@ SCENARIO("resource sources round-trips through serialization", "[resource_source
             auto data = entry.serialize(&original);
 
             ResourceSources<FakeResource> restored;
-            entry.deserialize(data, &restored, nlohmann::json{});
+            cask::LoadContext context;
+            entry.deserialize(data, &restored, context);
 
             THEN("the restored sources have the same json spec entries") {
                 REQUIRE(restored.entries.size() == original.entries.size());
@@ -259,7 +265,8 @@ SCENARIO("resource sources deserialization supports multiple loader types", "[re
 
         WHEN("the json is deserialized") {
             ResourceSources<FakeResource> sources;
-            entry.deserialize(data, &sources, nlohmann::json{});
+            cask::LoadContext context;
+            entry.deserialize(data, &sources, context);
 
             THEN("both loader types were invoked") {
                 REQUIRE(invoked_loaders.size() == 2);
@@ -270,8 +277,116 @@ SCENARIO("resource sources deserialization supports multiple loader types", "[re
             THEN("both resources are stored correctly") {
                 auto wall_handle = store.key_to_handle_.at("wall_mesh");
                 auto default_handle = store.key_to_handle_.at("default_value");
-                REQUIRE(store.resources_[wall_handle].data == static_cast<int>(std::string("meshes/wall.obj").size()));
-                REQUIRE(store.resources_[default_handle].data == 99);
+                REQUIRE(store.get(store.handle(wall_handle)).data == static_cast<int>(std::string("meshes/wall.obj").size()));
+                REQUIRE(store.get(store.handle(default_handle)).data == 99);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel resource sources deserialization commits handles in key order", "[resource_sources_serialization]") {
+    GIVEN("json data with several entries and a worker pool") {
+        nlohmann::json data = {
+            {"c_mesh", {{"loader", "inline"}, {"data", 3}}},
+            {"a_mesh", {{"loader", "inline"}, {"data", 1}}},
+            {"b_mesh", {{"loader", "inline"}, {"data", 2}}}
+        };
+
+        ResourceStore<FakeResource> store;
+        cask::ResourceLoaderRegistry<FakeResource> loader_registry;
+        loader_registry.add("inline", [](const nlohmann::json& entry_json) {
+            return FakeResource{entry_json["data"].get<int>()};
+        });
+
+        auto thread_count = GENERATE(0u, 4u);
+        cask::WorkerPool pool(thread_count);
+        auto entry = cask::describe_resource_sources<FakeResource>("MeshSources", store, loader_registry, pool);
+
+        WHEN("the json is deserialized") {
+            ResourceSources<FakeResource> sources;
+            cask::LoadContext context;
+            entry.deserialize(data, &sources, context);
+
+            THEN("handles follow sorted key order") {
+                REQUIRE(store.key_to_handle_.at("a_mesh") == 0);
+                REQUIRE(store.key_to_handle_.at("b_mesh") == 1);
+                REQUIRE(store.key_to_handle_.at("c_mesh") == 2);
+            }
+
+            THEN("each handle holds its loaded resource") {
+                REQUIRE(store.get(ResourceHandle<FakeResource>{0}).data == 1);
+                REQUIRE(store.get(ResourceHandle<FakeResource>{2}).data == 3);
+            }
+
+            THEN("the remap and sources entries are recorded") {
+                const auto& remap = context.resource_remaps.at("MeshSources");
+                REQUIRE(remap.at("b_mesh") == 1);
+                REQUIRE(sources.entries.size() == 3);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel resource sources deserialization runs loaders concurrently", "[resource_sources_serialization]") {
+    GIVEN("two entries whose loader waits for the other to start") {
+        nlohmann::json data = {
+            {"floor_mesh", {{"loader", "slow"}}},
+            {"wall_mesh", {{"loader", "slow"}}}
+        };
+
+        Rendezvous rendezvous(2);
+
+        ResourceStore<FakeResource> store;
+        cask::ResourceLoaderRegistry<FakeResource> loader_registry;
+        loader_registry.add("slow", [&rendezvous](const nlohmann::json&) {
+            rendezvous.arrive();
+            return FakeResource{0};
+        });
+
+        cask::WorkerPool pool(2);
+        auto entry = cask::describe_resource_sources<FakeResource>("MeshSources", store, loader_registry, pool);
+
+        WHEN("the json is deserialized") {
+            ResourceSources<FakeResource> sources;
+            cask::LoadContext context;
+            entry.deserialize(data, &sources, context);
+
+            THEN("both loaders overlapped") {
+                REQUIRE(rendezvous.overlapped == 2);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel resource sources deserialization propagates loader errors", "[resource_sources_serialization]") {
+    GIVEN("an entry whose loader throws") {
+        nlohmann::json data = {
+            {"broken_mesh", {{"loader", "broken"}}},
+            {"wall_mesh", {{"loader", "inline"}, {"data", 1}}}
+        };
+
+        ResourceStore<FakeResource> store;
+        cask::ResourceLoaderRegistry<FakeResource> loader_registry;
+        loader_registry.add("inline", [](const nlohmann::json& entry_json) {
+            return FakeResource{entry_json["data"].get<int>()};
+        });
+        loader_registry.add("broken", [](const nlohmann::json&) -> FakeResource {
+            throw std::runtime_error("cannot read broken_mesh");
+        });
+
+        cask::WorkerPool pool(2);
+        auto entry = cask::describe_resource_sources<FakeResource>("MeshSources", store, loader_registry, pool);
+
+        WHEN("the json is deserialized") {
+            ResourceSources<FakeResource> sources;
+            cask::LoadContext context;
+
+            THEN("it rethrows and commits nothing") {
+                REQUIRE_THROWS_WITH(
+                    entry.deserialize(data, &sources, context),
+                    Catch::Matchers::ContainsSubstring("broken_mesh")
+                );
+                REQUIRE(store.size() == 0);
             }
         }
     }
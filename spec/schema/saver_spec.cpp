@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 #include <cask/ecs/component_store.hpp>
+#include <cask/ecs/entity_compactor.hpp>
 #include <cask/ecs/entity_table.hpp>
 #include <cask/identity/entity_registry.hpp>
 #include <cask/identity/uuid.hpp>
@@ -140,3 +141,222 @@ SCENARIO("save then load round-trips component data", "[saver]") {
         }
     }
 }
+
+SCENARIO("saver and loader dispatch through interned component ids", "[saver]") {
+    GIVEN("a registry and a component table bound once by id") {
+        PhysicsConfig config{9.8f};
+
+        cask::SerializationRegistry registry;
+        uint32_t physics = registry.add("PhysicsConfig", physics_config_entry());
+
+        cask::ComponentTable components;
+        components.bind(physics, &config);
+
+        WHEN("the world is saved by id and loaded back into a fresh table") {
+            auto saved = cask::save(std::vector<uint32_t>{physics}, registry, components);
+
+            PhysicsConfig restored{};
+            cask::ComponentTable fresh;
+            fresh.bind(physics, &restored);
+            cask::load(saved, registry, fresh);
+
+            THEN("the file is keyed by component name") {
+                REQUIRE(saved["components"].contains("PhysicsConfig"));
+            }
+
+            THEN("the component round trips") {
+                REQUIRE(restored.gravity == Catch::Approx(9.8));
+            }
+        }
+    }
+}
+
+SCENARIO("delta saves patch a loaded world with only what changed", "[saver]") {
+    GIVEN("a saved world whose store changes after a baseline") {
+        EntityTable table;
+        EntityRegistry entities;
+        auto uuid_a = cask::generate_uuid();
+        auto uuid_b = cask::generate_uuid();
+        uint32_t a = entities.resolve(uuid_a, table);
+        uint32_t b = entities.resolve(uuid_b, table);
+
+        ComponentStore<Position> positions;
+        positions.insert(a, Position{1.0f, 1.0f});
+        positions.insert(b, Position{2.0f, 2.0f});
+
+        cask::SerializationRegistry registry;
+        uint32_t registry_id = registry.add("EntityRegistry", cask::describe_entity_registry("EntityRegistry", table));
+        uint32_t positions_id = registry.add("Positions", cask::describe_component_store<Position>("Positions", position_entry()));
+        std::vector<uint32_t> ids{registry_id, positions_id};
+
+        cask::ComponentTable components;
+        components.bind(registry_id, &entities);
+        components.bind(positions_id, &positions);
+
+        auto full = cask::save(ids, registry, components);
+        cask::rebase(ids, registry, components);
+
+        uint32_t c = entities.resolve(cask::generate_uuid(), table);
+        positions.insert(c, Position{3.0f, 3.0f});
+        positions.modify(a).x = 10.0f;
+        positions.remove(b);
+        entities.remove(b);
+        table.destroy(b);
+
+        EntityTable fresh_table;
+        EntityRegistry fresh_entities;
+        ComponentStore<Position> fresh_positions;
+        EntityCompactor fresh_compactor{&fresh_table, {}};
+        fresh_compactor.add(&fresh_positions, remove_component<Position>);
+        cask::SerializationRegistry load_registry;
+        load_registry.add("EntityRegistry", cask::describe_entity_registry("EntityRegistry", fresh_compactor));
+        load_registry.add("Positions", cask::describe_component_store<Position>("Positions", position_entry()));
+        cask::ComponentTable fresh;
+        fresh.bind(registry_id, &fresh_entities);
+        fresh.bind(positions_id, &fresh_positions);
+
+        auto context = cask::load(full, load_registry, fresh);
+
+        WHEN("a delta is saved and applied to the loaded world") {
+            auto patch = cask::save_delta(ids, registry, components);
+            cask::load_delta(patch, load_registry, fresh, context);
+
+            THEN("the patch only carries the changed components") {
+                REQUIRE(patch["components"]["Positions"]["upsert"].size() == 2);
+                REQUIRE(patch["components"]["Positions"]["remove"].size() == 1);
+                REQUIRE(patch["components"]["EntityRegistry"]["upsert"].size() == 1);
+                REQUIRE(patch["components"]["EntityRegistry"]["remove"].size() == 1);
+            }
+
+            THEN("the loaded world matches the saving world") {
+                REQUIRE(fresh_entities.size() == 2);
+                REQUIRE(fresh_entities.uuid_to_entity_.count(uuid_b) == 0);
+                REQUIRE(fresh_positions.dense_.size() == 2);
+                REQUIRE(fresh_positions.get(fresh_entities.resolve(uuid_a, fresh_table)).x == Catch::Approx(10.0));
+            }
+
+            THEN("the patch cannot be loaded as a full world") {
+                REQUIRE_THROWS(cask::load(patch, load_registry, fresh));
+            }
+        }
+
+        WHEN("a full save is applied as a delta") {
+            THEN("load_delta rejects it") {
+                REQUIRE_THROWS_WITH(
+                    cask::load_delta(full, load_registry, fresh, context),
+                    "full saves must be loaded with load"
+                );
+            }
+        }
+
+        WHEN("the world is rebased after a delta") {
+            cask::save_delta(ids, registry, components);
+            cask::rebase(ids, registry, components);
+
+            THEN("the next delta is empty") {
+                auto patch = cask::save_delta(ids, registry, components);
+                REQUIRE(patch["components"]["Positions"]["upsert"].empty());
+                REQUIRE(patch["components"]["Positions"]["remove"].empty());
+                REQUIRE(patch["components"]["EntityRegistry"]["upsert"].empty());
+                REQUIRE(patch["components"]["EntityRegistry"]["remove"].empty());
+            }
+        }
+    }
+}
+
+SCENARIO("delta saves drop entities whose id is recycled within one baseline", "[saver]") {
+    GIVEN("a world where a destroyed entity's id is reused before the delta is saved") {
+        EntityTable table;
+        EntityRegistry entities;
+        auto uuid_a = cask::generate_uuid();
+        auto uuid_b = cask::generate_uuid();
+        uint32_t a = entities.resolve(uuid_a, table);
+        uint32_t b = entities.resolve(uuid_b, table);
+
+        ComponentStore<Position> positions;
+        positions.insert(a, Position{1.0f, 1.0f});
+        positions.insert(b, Position{2.0f, 2.0f});
+
+        cask::SerializationRegistry registry;
+        uint32_t registry_id = registry.add("EntityRegistry", cask::describe_entity_registry("EntityRegistry", table));
+        uint32_t positions_id = registry.add("Positions", cask::describe_component_store<Position>("Positions", position_entry()));
+        std::vector<uint32_t> ids{registry_id, positions_id};
+
+        cask::ComponentTable components;
+        components.bind(registry_id, &entities);
+        components.bind(positions_id, &positions);
+
+        auto full = cask::save(ids, registry, components);
+        cask::rebase(ids, registry, components);
+
+        positions.remove(b);
+        entities.remove(b);
+        table.destroy(b);
+        auto uuid_c = cask::generate_uuid();
+        uint32_t c = entities.resolve(uuid_c, table);
+        positions.insert(c, Position{3.0f, 3.0f});
+
+        EntityTable fresh_table;
+        EntityRegistry fresh_entities;
+        ComponentStore<Position> fresh_positions;
+        EntityCompactor fresh_compactor{&fresh_table, {}};
+        fresh_compactor.add(&fresh_positions, remove_component<Position>);
+        cask::SerializationRegistry load_registry;
+        load_registry.add("EntityRegistry", cask::describe_entity_registry("EntityRegistry", fresh_compactor));
+        load_registry.add("Positions", cask::describe_component_store<Position>("Positions", position_entry()));
+        cask::ComponentTable fresh;
+        fresh.bind(registry_id, &fresh_entities);
+        fresh.bind(positions_id, &fresh_positions);
+
+        auto context = cask::load(full, load_registry, fresh);
+        uint32_t fresh_b = fresh_entities.resolve(uuid_b, fresh_table);
+        fresh_table.destroy(fresh_table.create());
+
+        WHEN("the delta is applied to the loaded world") {
+            auto patch = cask::save_delta(ids, registry, components);
+            cask::load_delta(patch, load_registry, fresh, context);
+
+            THEN("the new entity reused the removed entity's id") {
+                REQUIRE(c == b);
+            }
+
+            THEN("the removed entity's components are dropped") {
+                REQUIRE_FALSE(fresh_positions.has(fresh_b));
+                REQUIRE(fresh_positions.dense_.size() == 2);
+                REQUIRE(fresh_positions.get(fresh_entities.resolve(uuid_c, fresh_table)).x == Catch::Approx(3.0));
+            }
+        }
+
+        WHEN("the loading registry has no compactor") {
+            cask::SerializationRegistry bare_registry;
+            bare_registry.add("EntityRegistry", cask::describe_entity_registry("EntityRegistry", fresh_table));
+            bare_registry.add("Positions", cask::describe_component_store<Position>("Positions", position_entry()));
+            auto patch = cask::save_delta(ids, registry, components);
+
+            THEN("removing entities throws") {
+                REQUIRE_THROWS_WITH(
+                    cask::load_delta(patch, bare_registry, fresh, context),
+                    Catch::Matchers::ContainsSubstring("EntityCompactor")
+                );
+            }
+        }
+    }
+}
+
+SCENARIO("saver rejects components with no bound instance", "[saver]") {
+    GIVEN("a registered component the table has no instance for") {
+        cask::SerializationRegistry registry;
+        uint32_t physics = registry.add("PhysicsConfig", physics_config_entry());
+
+        THEN("save and save_delta throw naming the component") {
+            REQUIRE_THROWS_WITH(
+                cask::save(std::vector<uint32_t>{physics}, registry, cask::ComponentTable{}),
+                Catch::Matchers::ContainsSubstring("PhysicsConfig")
+            );
+            REQUIRE_THROWS_WITH(
+                cask::save_delta(std::vector<uint32_t>{physics}, registry, cask::ComponentTable{}),
+                Catch::Matchers::ContainsSubstring("PhysicsConfig")
+            );
+        }
+    }
+}
@@ -8,7 +8,7 @@ SCENARIO("registry stores and retrieves entries", "[serialization_registry]") {
         cask::RegistryEntry entry{
             nlohmann::json{{"name", "Position"}},
             [](const void*) { return nlohmann::json{{"x", 1.0}}; },
-            [](const nlohmann::json&, void*, const nlohmann::json&) { return nlohmann::json::object(); },
+            [](const nlohmann::json&, void*, cask::LoadContext&) {},
             {}
         };
 
@@ -46,7 +46,7 @@ SCENARIO("registry entry has empty dependencies by default", "[serialization_reg
         cask::RegistryEntry entry{
             nlohmann::json{{"name", "Position"}},
             [](const void*) { return nlohmann::json{}; },
-            [](const nlohmann::json&, void*, const nlohmann::json&) { return nlohmann::json::object(); },
+            [](const nlohmann::json&, void*, cask::LoadContext&) {},
             {}
         };
 
@@ -61,7 +61,7 @@ SCENARIO("registry entry stores dependencies", "[serialization_registry]") {
         cask::RegistryEntry entry{
             nlohmann::json{{"name", "Positions"}},
             [](const void*) { return nlohmann::json{}; },
-            [](const nlohmann::json&, void*, const nlohmann::json&) { return nlohmann::json::object(); },
+            [](const nlohmann::json&, void*, cask::LoadContext&) {},
             {"EntityRegistry"}
         };
 
@@ -72,28 +72,96 @@ SCENARIO("registry entry stores dependencies", "[serialization_registry]") {
     }
 }
 
-SCENARIO("deserialize function receives context and returns context contributions", "[serialization_registry]") {
-    GIVEN("a registry entry whose deserializer produces context") {
+SCENARIO("deserialize function writes into the load context", "[serialization_registry]") {
+    GIVEN("a registry entry whose deserializer produces an entity remap") {
         cask::RegistryEntry entry{
             nlohmann::json{{"name", "Producer"}},
             [](const void*) { return nlohmann::json{}; },
-            [](const nlohmann::json&, void*, const nlohmann::json&) {
-                return nlohmann::json{{"entity_remap", {{"42", 8}}}};
+            [](const nlohmann::json&, void*, cask::LoadContext& context) {
+                context.entity_remap.set(42, 8);
             },
             {}
         };
 
         WHEN("deserialize is called") {
-            nlohmann::json context;
-            auto contributions = entry.deserialize(nlohmann::json{}, nullptr, context);
+            cask::LoadContext context;
+            entry.deserialize(nlohmann::json{}, nullptr, context);
 
-            THEN("it returns the context contributions") {
-                REQUIRE(contributions["entity_remap"]["42"] == 8);
+            THEN("the context holds the produced remap") {
+                REQUIRE(context.entity_remap.at(42) == 8);
             }
         }
     }
 }
 
+SCENARIO("entity remap is a dense table indexed by file-local id", "[serialization_registry]") {
+    GIVEN("a remap with two sparse entries") {
+        cask::EntityRemap remap;
+        remap.set(3, 100);
+        remap.set(7, 200);
+
+        THEN("mapped entities resolve by index") {
+            REQUIRE(remap.at(3) == 100);
+            REQUIRE(remap.at(7) == 200);
+        }
+
+        THEN("the table grows to the largest file-local id") {
+            REQUIRE(remap.table_.size() == 8);
+        }
+
+        THEN("gaps and out-of-range ids are unmapped") {
+            REQUIRE_FALSE(remap.has(5));
+            REQUIRE_FALSE(remap.has(8));
+            REQUIRE_THROWS_WITH(remap.at(5), Catch::Matchers::ContainsSubstring("5"));
+        }
+    }
+}
+
+SCENARIO("entity remap keeps far-out file-local ids out of the dense table", "[serialization_registry]") {
+    GIVEN("a remap with one small id and one id near the top of the range") {
+        cask::EntityRemap remap;
+        remap.set(2, 10);
+        remap.set(4'000'000'000u, 20);
+
+        THEN("both ids resolve") {
+            REQUIRE(remap.at(2) == 10);
+            REQUIRE(remap.at(4'000'000'000u) == 20);
+            REQUIRE(remap.size() == 2);
+        }
+
+        THEN("the dense table stays bounded by the number of mapped entities") {
+            REQUIRE(remap.table_.size() <= cask::ENTITY_REMAP_DENSE_MINIMUM);
+            REQUIRE(remap.sparse_.size() == 1);
+        }
+
+        WHEN("enough entities are mapped for the dense table to cover a sparse id") {
+            for (uint32_t entity = 0; entity < 2000; ++entity) {
+                remap.set(entity, entity + 1000);
+            }
+            remap.set(1500, 7);
+            remap.set(3000, 8);
+
+            THEN("ids that moved into the dense table still resolve and are counted once") {
+                REQUIRE(remap.at(1500) == 7);
+                REQUIRE(remap.at(3000) == 8);
+                REQUIRE(remap.at(4'000'000'000u) == 20);
+                REQUIRE(remap.size() == 2002);
+            }
+        }
+    }
+}
+
+SCENARIO("entity ids are parsed from json object keys", "[serialization_registry]") {
+    THEN("numeric keys parse") {
+        REQUIRE(cask::parse_entity_id("42") == 42);
+    }
+
+    THEN("non-numeric keys throw") {
+        REQUIRE_THROWS(cask::parse_entity_id("4x"));
+        REQUIRE_THROWS(cask::parse_entity_id(""));
+    }
+}
+
 SCENARIO("registry throws for missing entries", "[serialization_registry]") {
     GIVEN("an empty registry") {
         cask::SerializationRegistry registry;
@@ -105,3 +173,34 @@ SCENARIO("registry throws for missing entries", "[serialization_registry]") {
         }
     }
 }
+
+SCENARIO("registry names resolve to stable ids", "[serialization_registry]") {
+    GIVEN("a registry with two entries") {
+        cask::SerializationRegistry registry;
+        auto empty = [](const char* name) {
+            return cask::RegistryEntry{
+                nlohmann::json{{"name", name}},
+                [](const void*) { return nlohmann::json{}; },
+                [](const nlohmann::json&, void*, cask::LoadContext&) {},
+                {}
+            };
+        };
+        uint32_t position = registry.add("Position", empty("Position"));
+        uint32_t velocity = registry.add("Velocity", empty("Velocity"));
+
+        THEN("each name gets its own dense id") {
+            REQUIRE(position == 0);
+            REQUIRE(velocity == 1);
+            REQUIRE(registry.id(std::string_view("Velocity")) == velocity);
+        }
+
+        THEN("get by id returns the same entry as get by name") {
+            REQUIRE(&registry.get(velocity) == &registry.get("Velocity"));
+        }
+
+        THEN("adding an existing name keeps the first entry and id") {
+            REQUIRE(registry.add("Position", empty("Other")) == position);
+            REQUIRE(registry.get(position).schema["name"] == "Position");
+        }
+    }
+}
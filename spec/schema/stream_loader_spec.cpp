@@ -0,0 +1,254 @@
+#include <catch2/catch_all.hpp>
+#include <cask/ecs/component_store.hpp>
+#include <cask/ecs/entity_table.hpp>
+#include <cask/identity/entity_registry.hpp>
+#include <cask/identity/uuid.hpp>
+#include <cask/schema/describe_component_store.hpp>
+#include <cask/schema/describe_entity_registry.hpp>
+#include <cask/schema/saver.hpp>
+#include <cask/schema/stream_loader.hpp>
+#include <sstream>
+#include "../support/schema_fixtures.hpp"
+
+using fixtures::PhysicsConfig;
+using fixtures::physics_config_entry;
+using fixtures::Position;
+using fixtures::position_entry;
+
+namespace {
+
+cask::RegistryEntry recording_entry(const std::string& name, std::vector<std::string>& order) {
+    return cask::RegistryEntry{
+        nlohmann::json{{"name", name}},
+        [](const void*) { return nlohmann::json{}; },
+        [name, &order](const nlohmann::json&, void*, cask::LoadContext&) {
+            order.push_back(name);
+        },
+        {}
+    };
+}
+
+}
+
+SCENARIO("stream loader deserializes a saved file without a full parse", "[stream_loader]") {
+    GIVEN("a saved world with an entity registry and a component store") {
+        EntityTable table;
+        EntityRegistry registry;
+
+        auto uuid_a = cask::generate_uuid();
+        auto uuid_b = cask::generate_uuid();
+        uint32_t original_a = registry.resolve(uuid_a, table);
+        uint32_t original_b = registry.resolve(uuid_b, table);
+
+        ComponentStore<Position> original_store;
+        original_store.insert(original_a, Position{1.0f, 2.0f});
+        original_store.insert(original_b, Position{3.0f, 4.0f});
+
+        auto val_entry = position_entry();
+        auto store_entry = cask::describe_component_store<Position>("Positions", val_entry);
+
+        cask::SerializationRegistry save_registry;
+        save_registry.add("EntityRegistry", cask::describe_entity_registry("EntityRegistry", table));
+        save_registry.add("Positions", store_entry);
+
+        auto saved = cask::save({"EntityRegistry", "Positions"}, save_registry, [&](const std::string& name) -> void* {
+            if (name == "EntityRegistry") return &registry;
+            return &original_store;
+        });
+        std::istringstream input(saved.dump());
+
+        EntityTable fresh_table;
+        EntityRegistry fresh_registry;
+        ComponentStore<Position> fresh_store;
+
+        cask::SerializationRegistry load_registry;
+        load_registry.add("EntityRegistry", cask::describe_entity_registry("EntityRegistry", fresh_table));
+        load_registry.add("Positions", store_entry);
+
+        cask::ComponentResolver resolver = [&](const std::string& name) -> void* {
+            if (name == "EntityRegistry") return &fresh_registry;
+            if (name == "Positions") return &fresh_store;
+            return nullptr;
+        };
+
+        WHEN("the stream is loaded") {
+            auto context = cask::load_stream(input, load_registry, resolver);
+
+            THEN("the entity registry has the same UUIDs") {
+                REQUIRE(fresh_registry.size() == 2);
+            }
+
+            THEN("the component store has remapped entities with correct data") {
+                auto& pos_a = fresh_store.get(fresh_registry.resolve(uuid_a, fresh_table));
+                REQUIRE(pos_a.x == Catch::Approx(1.0));
+                REQUIRE(pos_a.y == Catch::Approx(2.0));
+
+                auto& pos_b = fresh_store.get(fresh_registry.resolve(uuid_b, fresh_table));
+                REQUIRE(pos_b.x == Catch::Approx(3.0));
+                REQUIRE(pos_b.y == Catch::Approx(4.0));
+            }
+
+            THEN("the context maps file-local entities to runtime entities") {
+                REQUIRE(context.entity_remap.at(original_a) == fresh_registry.resolve(uuid_a, fresh_table));
+                REQUIRE(context.entity_remap.at(original_b) == fresh_registry.resolve(uuid_b, fresh_table));
+            }
+        }
+    }
+}
+
+SCENARIO("stream loader buffers sections that arrive before their dependencies", "[stream_loader]") {
+    GIVEN("a stream where a dependent section precedes its dependency") {
+        std::vector<std::string> order;
+
+        cask::SerializationRegistry registry;
+        auto dependent = recording_entry("Dependent", order);
+        dependent.dependencies = {"Base"};
+        registry.add("Dependent", dependent);
+        registry.add("Base", recording_entry("Base", order));
+
+        int dummy = 0;
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &dummy; };
+
+        std::istringstream input(R"({"components": {"Dependent": {}, "Base": {}}, "dependencies": {"Dependent": ["Base"]}})");
+
+        WHEN("the stream is loaded") {
+            cask::load_stream(input, registry, resolver);
+
+            THEN("the dependency is deserialized first") {
+                REQUIRE(order == std::vector<std::string>{"Base", "Dependent"});
+            }
+        }
+    }
+}
+
+SCENARIO("stream loader honours a dependencies section that precedes the components", "[stream_loader]") {
+    GIVEN("a stream declaring file dependencies before any component section") {
+        std::vector<std::string> order;
+
+        cask::SerializationRegistry registry;
+        registry.add("A", recording_entry("A", order));
+        registry.add("B", recording_entry("B", order));
+
+        int dummy = 0;
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &dummy; };
+
+        std::istringstream input(R"({"dependencies": {"A": ["B"]}, "components": {"A": {}, "B": {}}})");
+
+        WHEN("the stream is loaded") {
+            cask::load_stream(input, registry, resolver);
+
+            THEN("components are deserialized in dependency order") {
+                REQUIRE(order == std::vector<std::string>{"B", "A"});
+            }
+        }
+    }
+}
+
+SCENARIO("stream loader handles singletons with scalar fields", "[stream_loader]") {
+    GIVEN("a stream containing a singleton component") {
+        PhysicsConfig config{};
+
+        cask::SerializationRegistry registry;
+        registry.add("PhysicsConfig", physics_config_entry());
+
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &config; };
+
+        std::istringstream input(R"({"components": {"PhysicsConfig": {"gravity": 9.8}}, "dependencies": {}})");
+
+        WHEN("the stream is loaded") {
+            cask::load_stream(input, registry, resolver);
+
+            THEN("the singleton has the correct values") {
+                REQUIRE(config.gravity == Catch::Approx(9.8));
+            }
+        }
+    }
+}
+
+SCENARIO("stream loader detects circular dependencies", "[stream_loader]") {
+    GIVEN("a stream whose components depend on each other") {
+        std::vector<std::string> order;
+
+        cask::SerializationRegistry registry;
+        auto entry_a = recording_entry("A", order);
+        entry_a.dependencies = {"B"};
+        auto entry_b = recording_entry("B", order);
+        entry_b.dependencies = {"A"};
+        registry.add("A", entry_a);
+        registry.add("B", entry_b);
+
+        int dummy = 0;
+        cask::ComponentResolver resolver = [&](const std::string&) -> void* { return &dummy; };
+
+        std::istringstream input(R"({"components": {"A": {}, "B": {}}, "dependencies": {"A": ["B"], "B": ["A"]}})");
+
+        WHEN("the stream is loaded") {
+            THEN("it throws a cycle detection error and deserializes nothing") {
+                REQUIRE_THROWS(cask::load_stream(input, registry, resolver));
+                REQUIRE(order.empty());
+            }
+        }
+    }
+}
+
+SCENARIO("stream loader propagates malformed json", "[stream_loader]") {
+    GIVEN("a truncated stream") {
+        cask::SerializationRegistry registry;
+        cask::ComponentResolver resolver = [](const std::string&) -> void* { return nullptr; };
+
+        std::istringstream input(R"({"components": {"A": {)");
+
+        THEN("loading throws") {
+            REQUIRE_THROWS(cask::load_stream(input, registry, resolver));
+        }
+    }
+}
+
+SCENARIO("stream loader rejects a stream without a components section", "[stream_loader]") {
+    GIVEN("a stream holding only dependencies") {
+        cask::SerializationRegistry registry;
+        cask::ComponentResolver resolver = [](const std::string&) -> void* { return nullptr; };
+
+        std::istringstream input(R"({"dependencies": {}})");
+
+        THEN("loading throws") {
+            REQUIRE_THROWS_WITH(cask::load_stream(input, registry, resolver), Catch::Matchers::ContainsSubstring("components"));
+        }
+    }
+}
+
+SCENARIO("stream loader rejects components with no bound instance", "[stream_loader]") {
+    GIVEN("a stream naming a component the table has no instance for") {
+        cask::SerializationRegistry registry;
+        registry.add("PhysicsConfig", physics_config_entry());
+
+        std::istringstream input(R"({"components": {"PhysicsConfig": {"gravity": 9.8}}, "dependencies": {}})");
+
+        THEN("loading throws naming the component") {
+            REQUIRE_THROWS_WITH(
+                cask::load_stream(input, registry, cask::ComponentTable{}),
+                Catch::Matchers::ContainsSubstring("PhysicsConfig")
+            );
+        }
+    }
+}
+
+SCENARIO("stream loader rejects delta saves", "[stream_loader]") {
+    GIVEN("a stream flagged as a delta") {
+        std::vector<std::string> order;
+
+        cask::SerializationRegistry registry;
+        uint32_t section = registry.add("Section", recording_entry("Section", order));
+
+        int dummy = 0;
+        cask::ComponentTable components;
+        components.bind(section, &dummy);
+
+        std::istringstream input(cask::save_delta(std::vector<uint32_t>{section}, registry, components).dump());
+
+        THEN("loading throws before any section is applied") {
+            REQUIRE_THROWS_WITH(cask::load_stream(input, registry, components), "delta saves must be applied with load_delta");
+            REQUIRE(order.empty());
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Each arrival waits up to two seconds for the others. An arrival that sees every party
+// counts as overlapped, so overlapped == parties only when they all ran at the same time.
+struct Rendezvous {
+    int parties;
+    std::atomic<int> started{0};
+    std::atomic<int> overlapped{0};
+
+    explicit Rendezvous(int parties) : parties(parties) {}
+
+    void arrive() {
+        started++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (started < parties && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        if (started == parties) {
+            overlapped++;
+        }
+    }
+};
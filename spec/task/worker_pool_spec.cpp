@@ -0,0 +1,112 @@
+#include <catch2/catch_all.hpp>
+#include <cask/task/worker_pool.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include "../support/rendezvous.hpp"
+
+SCENARIO("a worker pool runs submitted tasks on its threads", "[worker_pool]") {
+    GIVEN("a pool with two threads") {
+        std::atomic<int> completed{0};
+
+        WHEN("several tasks are submitted and the pool is destroyed") {
+            {
+                cask::WorkerPool pool(2);
+                for (int index = 0; index < 8; ++index) {
+                    pool.submit([&completed] { completed++; });
+                }
+            }
+
+            THEN("every task has run") {
+                REQUIRE(completed == 8);
+            }
+        }
+    }
+}
+
+SCENARIO("a worker pool without threads runs tasks on the caller", "[worker_pool]") {
+    GIVEN("a pool with zero threads and a submitted task") {
+        cask::WorkerPool pool(0);
+        std::thread::id ran_on;
+        pool.submit([&ran_on] { ran_on = std::this_thread::get_id(); });
+
+        WHEN("run_one is called") {
+            bool ran = pool.run_one();
+
+            THEN("the task runs on the calling thread") {
+                REQUIRE(ran);
+                REQUIRE(ran_on == std::this_thread::get_id());
+            }
+
+            THEN("the queue is then empty") {
+                REQUIRE_FALSE(pool.run_one());
+            }
+        }
+    }
+}
+
+SCENARIO("a worker pool runs independent tasks concurrently", "[worker_pool]") {
+    GIVEN("a pool with two threads and two tasks that wait for each other") {
+        Rendezvous rendezvous(2);
+
+        WHEN("both tasks are submitted") {
+            {
+                cask::WorkerPool pool(2);
+                pool.submit([&rendezvous] { rendezvous.arrive(); });
+                pool.submit([&rendezvous] { rendezvous.arrive(); });
+            }
+
+            THEN("both observed the other running") {
+                REQUIRE(rendezvous.overlapped == 2);
+            }
+        }
+    }
+}
+
+SCENARIO("a task group waits for all of its tasks", "[worker_pool]") {
+    GIVEN("a pool and a group of tasks") {
+        auto thread_count = GENERATE(0u, 2u);
+        cask::WorkerPool pool(thread_count);
+        std::atomic<int> completed{0};
+
+        WHEN("the group waits") {
+            cask::TaskGroup group(pool);
+            for (int index = 0; index < 16; ++index) {
+                group.run([&completed] { completed++; });
+            }
+            group.wait();
+
+            THEN("every task has finished") {
+                REQUIRE(completed == 16);
+            }
+        }
+
+        WHEN("a task waits on a nested group") {
+            cask::TaskGroup outer(pool);
+            outer.run([&pool, &completed] {
+                cask::TaskGroup inner(pool);
+                for (int index = 0; index < 4; ++index) {
+                    inner.run([&completed] { completed++; });
+                }
+                inner.wait();
+            });
+            outer.wait();
+
+            THEN("the nested tasks complete without deadlock") {
+                REQUIRE(completed == 4);
+            }
+        }
+    }
+}
+
+SCENARIO("a task group rethrows the first task error", "[worker_pool]") {
+    GIVEN("a group with a failing task") {
+        cask::WorkerPool pool(1);
+        cask::TaskGroup group(pool);
+        group.run([] { throw std::runtime_error("task failed"); });
+
+        THEN("wait rethrows it") {
+            REQUIRE_THROWS_WITH(group.wait(), Catch::Matchers::ContainsSubstring("task failed"));
+        }
+    }
+}